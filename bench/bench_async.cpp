@@ -0,0 +1,156 @@
+#include <algorithm> //std::min, std::max
+#include <cstdio>
+#include <string>
+#include <utility> //std::swap
+#include <vector>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Checkpointing a field between compute steps. A 1-d smoothing stencil stands in for the
+// compute, and after every step the field is written to a dataset of its own, either blocking
+// the compute or on the I/O thread of an H5AsyncWriter, from a copy taken on submission or from
+// recycled buffers filled directly (double buffering). Every rank works on its own serially
+// accessed files.
+//
+// H5WrapperBench async [--mb=32] [--steps=8] [--sweeps=20]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+struct Checkpoint {
+    H5File                 file;
+    std::vector<H5Dataset> steps;
+};
+
+Checkpoint create_checkpoint(const std::string& name, size_t n, size_t n_steps) {
+    H5FileAccessProperty fapl;
+    fapl.set_serial();
+    Checkpoint ret;
+    ret.file = H5File::create(name, H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+    for (size_t s = 0; s < n_steps; ++s) {
+        ret.steps.push_back(H5Dataset::create(ret.file,
+                                              "step_" + std::to_string(s),
+                                              H5DatatypeCreator<double>::create(),
+                                              H5Dataspace::create({n})));
+    }
+    return ret;
+}
+
+// smoothing sweeps over the interior, result in field
+void compute(std::vector<double>& field, std::vector<double>& scratch, size_t sweeps) {
+    const size_t n = field.size();
+    for (size_t s = 0; s < sweeps; ++s) {
+        scratch[0]     = field[0];
+        scratch[n - 1] = field[n - 1];
+        for (size_t i = 1; i + 1 < n; ++i) {
+            scratch[i] = 0.5 * field[i] + 0.25 * (field[i - 1] + field[i + 1]);
+        }
+        std::swap(field, scratch);
+    }
+}
+
+void run_async(const Arguments& args) {
+
+    const size_t mb      = arg_value(args, "mb", 32);
+    const size_t n_steps = arg_value(args, "steps", 8);
+    const size_t sweeps  = std::max<size_t>(arg_value(args, "sweeps", 20), 1);
+    const size_t n       = mb * (size_t(1) << 20) / sizeof(double);
+
+    const std::string prefix = "bench_async_" + std::to_string(mpi_rank());
+
+    std::vector<double> field(n), scratch(n);
+    for (size_t i = 0; i < n; ++i) { field[i] = double(i % 1024); }
+
+    auto run_case = [&](const std::string& name, auto&& step) {
+        auto checkpoint = create_checkpoint(prefix + "_" + name + ".h5", n, n_steps);
+        mpi_wait();
+        Timer timer;
+        step(checkpoint);
+        const double t = mpi_max(timer.elapsed());
+        checkpoint.steps.clear();
+        checkpoint.file.close();
+        std::remove((prefix + "_" + name + ".h5").c_str());
+        return t;
+    };
+
+    const double t_compute = run_case("compute", [&](Checkpoint&) {
+        for (size_t s = 0; s < n_steps; ++s) { compute(field, scratch, sweeps); }
+    });
+
+    const double t_io = run_case("io", [&](Checkpoint& c) {
+        for (size_t s = 0; s < n_steps; ++s) { c.steps[s].write(field.data()); }
+    });
+
+    const double t_sync = run_case("sync", [&](Checkpoint& c) {
+        for (size_t s = 0; s < n_steps; ++s) {
+            compute(field, scratch, sweeps);
+            c.steps[s].write(field.data());
+        }
+    });
+
+    const double t_copy = run_case("copy", [&](Checkpoint& c) {
+        H5AsyncWriter writer;
+        for (size_t s = 0; s < n_steps; ++s) {
+            compute(field, scratch, sweeps);
+            writer.write_copy(c.steps[s], field);
+        }
+        writer.flush();
+    });
+
+    // the last sweep also stores into a recycled buffer of the writer instead of copying after
+    const double t_double = run_case("double", [&](Checkpoint& c) {
+        H5AsyncWriter writer(2 * n * sizeof(double));
+        for (size_t s = 0; s < n_steps; ++s) {
+            compute(field, scratch, sweeps - 1);
+            auto buffer   = writer.make_buffer<double>({n});
+            buffer[0]     = scratch[0] = field[0];
+            buffer[n - 1] = scratch[n - 1] = field[n - 1];
+            for (size_t i = 1; i + 1 < n; ++i) {
+                buffer[i] = scratch[i] = 0.5 * field[i] + 0.25 * (field[i - 1] + field[i + 1]);
+            }
+            std::swap(field, scratch);
+            writer.write(c.steps[s], std::move(buffer));
+        }
+        writer.flush();
+    });
+
+    const std::vector<std::pair<std::string, double>> results = {{"compute only", t_compute},
+                                                                 {"write only", t_io},
+                                                                 {"compute + write", t_sync},
+                                                                 {"async copy", t_copy},
+                                                                 {"async double buffer", t_double}};
+
+    // fraction of the shorter of compute and I/O hidden behind the other
+    auto overlap = [&](double t) {
+        return (t_compute + t_io - t) / std::min(t_compute, t_io);
+    };
+
+    if (mpi_rank() == 0) {
+        std::printf("async: %zu MB x %zu steps, %zu sweeps, %zu ranks\n",
+                    mb,
+                    n_steps,
+                    sweeps,
+                    mpi_size());
+        std::printf("%-24s %12s %10s\n", "case", "time [ms]", "overlap");
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& [name, t] = results[i];
+        if (i < 2) {
+            report().add("async", name, {{"time_s", t}});
+            if (mpi_rank() == 0) { std::printf("%-24s %12.3f %10s\n", name.c_str(), t * 1e3, "-"); }
+            continue;
+        }
+        report().add("async", name, {{"time_s", t}, {"overlap", overlap(t)}});
+        if (mpi_rank() == 0) {
+            std::printf("%-24s %12.3f %10.2f\n", name.c_str(), t * 1e3, overlap(t));
+        }
+    }
+}
+
+Registration registration("async", run_async);
+
+} // namespace
@@ -0,0 +1,96 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Plane by plane sweeps along each axis of a deflate compressed n x n x n field of doubles in
+// chunks of c x c x c, opened with the default chunk cache (1 MiB) and with the cache sized for
+// the sweep by H5Dataset::open with H5AccessPattern::planes. A plane touches (n / c)^2 chunks,
+// which do not fit the default cache for the default sizes, so every chunk is decompressed again
+// for every plane through it. Every rank works on its own serially accessed file.
+//
+// H5WrapperBench chunk_cache [--n=128] [--chunk=32]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+double sweep(H5Dataset ds, size_t axis, size_t n) {
+    std::vector<size_t> start(3, 0), count(3, n);
+    count[axis] = 1;
+    std::vector<double> plane(n * n);
+    auto                memory_space = H5Dataspace::create({n * n});
+
+    mpi_wait();
+    Timer timer;
+    for (size_t i = 0; i < n; ++i) {
+        start[axis] = i;
+        auto slab   = H5Hyperslab::select(ds.cached_dataspace(), start, count);
+        ds.read(plane.data(), memory_space, slab);
+    }
+    return mpi_max(timer.elapsed());
+}
+
+void run_chunk_cache(const Arguments& args) {
+
+    const size_t n     = arg_value(args, "n", 128);
+    const size_t chunk = arg_value(args, "chunk", 32);
+
+    const std::string fname = "bench_chunk_cache_" + std::to_string(mpi_rank()) + ".h5";
+
+    H5FileAccessProperty fapl;
+    fapl.set_serial();
+    {
+        auto hf =
+            H5File::create(fname, H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+        H5DatasetCreateProperty dcpl;
+        dcpl.set_chunk({chunk, chunk, chunk});
+        dcpl.set_shuffle();
+        dcpl.set_deflate(1);
+        auto ds = H5Dataset::create(hf,
+                                    "field",
+                                    H5DatatypeCreator<double>::create(),
+                                    H5Dataspace::create({n, n, n}),
+                                    H5LinkCreateProperty(),
+                                    dcpl);
+        std::vector<double> field(n * n * n);
+        for (size_t i = 0; i < field.size(); ++i) { field[i] = std::sin(0.001 * double(i)); }
+        ds.write(field.data());
+    }
+
+    auto hf = H5File::open(fname, H5File::AccessFlag::READ, fapl);
+
+    if (mpi_rank() == 0) {
+        std::printf(
+            "chunk_cache: %zu^3 doubles in %zu^3 chunks, %zu ranks\n", n, chunk, mpi_size());
+        std::printf("%-8s %16s %16s %10s\n", "axis", "default [ms]", "fitted [ms]", "speedup");
+    }
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const double t_default = sweep(H5Dataset::open(hf, "field"), axis, n);
+        const double t_fitted =
+            sweep(H5Dataset::open(hf, "field", H5AccessPattern::planes(axis)), axis, n);
+
+        const std::string name = "axis " + std::to_string(axis);
+        report().add("chunk_cache", name + " default", {{"time_s", t_default}});
+        report().add("chunk_cache", name + " fitted", {{"time_s", t_fitted}});
+        if (mpi_rank() == 0) {
+            std::printf("%-8s %16.3f %16.3f %10.2f\n",
+                        name.c_str(),
+                        t_default * 1e3,
+                        t_fitted * 1e3,
+                        t_default / t_fitted);
+        }
+    }
+
+    hf.close();
+    std::remove(fname.c_str());
+}
+
+Registration registration("chunk_cache", run_chunk_cache);
+
+} // namespace
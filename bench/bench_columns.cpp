@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Particle records of 20 doubles stored as a compound dataset, written from an array of structs
+// and from 20 separate columns, and read back whole against reading only x, y and z as columns.
+// Every rank works on its own serially accessed file.
+//
+// H5WrapperBench columns [--particles=200000] [--reps=5]
+
+namespace {
+
+struct Particle {
+    double x, y, z, vx, vy, vz, ax, ay, az, mass, charge, energy, pressure, density, temperature,
+        smoothing, potential, age, metallicity, id;
+};
+
+} // namespace
+
+H5WRAPPER_COMPOUND(Particle, x, y, z, vx, vy, vz, ax, ay, az, mass, charge, energy, pressure,
+                   density, temperature, smoothing, potential, age, metallicity, id)
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+constexpr size_t n_fields = sizeof(Particle) / sizeof(double);
+
+template <class Op> double time_op(size_t reps, Op&& op) {
+    mpi_wait();
+    Timer timer;
+    for (size_t r = 0; r < reps; ++r) { op(); }
+    return mpi_max(timer.elapsed()) / double(reps);
+}
+
+void run_columns(const Arguments& args) {
+
+    const size_t n    = arg_value(args, "particles", 200000);
+    const size_t reps = arg_value(args, "reps", 5);
+
+    const std::string fname = "bench_columns_" + std::to_string(mpi_rank()) + ".h5";
+
+    H5FileAccessProperty fapl;
+    fapl.set_serial();
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+    auto ds = H5Dataset::create(
+        hf, "particles", H5DatatypeCreator<Particle>::create(), H5Dataspace::create({n}));
+
+    std::vector<Particle>            structs(n);
+    std::vector<std::vector<double>> fields(n_fields, std::vector<double>(n, 1.0));
+    auto                             type = H5DatatypeCreator<Particle>::create();
+    std::vector<H5Column>            all;
+    for (size_t f = 0; f < n_fields; ++f) { all.emplace_back(type.get_member_name(f), fields[f]); }
+
+    std::vector<double> x(n), y(n), z(n);
+
+    const double bytes  = double(n * sizeof(Particle));
+    const double t_aos  = time_op(reps, [&]() { ds.write(structs); });
+    const double t_soa  = time_op(reps, [&]() { ds.write_columns(all); });
+    const double t_all  = time_op(reps, [&]() { ds.read(structs); });
+    const double t_xyz  = time_op(reps, [&]() {
+        ds.read_columns({H5Column("x", x), H5Column("y", y), H5Column("z", z)});
+    });
+    const double t_each = time_op(reps, [&]() {
+        ds.read_columns({H5Column("x", x)});
+        ds.read_columns({H5Column("y", y)});
+        ds.read_columns({H5Column("z", z)});
+    });
+
+    const std::vector<std::pair<std::string, double>> results = {{"write structs", t_aos},
+                                                                 {"write 20 columns", t_soa},
+                                                                 {"read structs", t_all},
+                                                                 {"read x,y,z", t_xyz},
+                                                                 {"read x,y,z one by one", t_each}};
+
+    if (mpi_rank() == 0) {
+        std::printf("columns: %zu particles of %zu fields, %zu ranks\n", n, n_fields, mpi_size());
+        std::printf("%-24s %12s\n", "case", "time [ms]");
+    }
+    for (const auto& [name, t] : results) {
+        report().add("columns", name, {{"time_s", t}, {"record_MB_per_s", bytes / t / 1e6}});
+        if (mpi_rank() == 0) { std::printf("%-24s %12.3f\n", name.c_str(), t * 1e3); }
+    }
+}
+
+Registration registration("columns", run_columns);
+
+} // namespace
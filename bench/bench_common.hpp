@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm> //std::sort
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <mpi.h>
+#include <numeric> //std::accumulate
+#include <string>
+#include <sys/stat.h> //stat buffer
+#include <utility>    //std::move
+#include <vector>
+
+namespace H5WrapperBench {
+
+using Arguments = std::vector<std::string>;
+using Suite     = std::function<void(const Arguments&)>;
+
+///
+///@brief Returns the registry of all benchmark suites, filled by Registration objects.
+///
+///@return std::map<std::string, Suite>& suites by name
+///
+inline std::map<std::string, Suite>& suites() {
+    static std::map<std::string, Suite> registry;
+    return registry;
+}
+
+///
+///@brief Registers a benchmark suite under a name at static initialization time.
+///
+///
+struct Registration {
+    Registration(const std::string& name, Suite suite) { suites()[name] = std::move(suite); }
+};
+
+///
+///@brief Wall clock timer started on construction.
+///
+///
+class Timer {
+
+public:
+    Timer()
+        : m_start(clock::now()) {}
+
+    void restart() { m_start = clock::now(); }
+
+    ///
+    ///@brief Returns the time since construction or the last restart.
+    ///
+    ///@return double elapsed time in seconds
+    ///
+    double elapsed() const { return std::chrono::duration<double>(clock::now() - m_start).count(); }
+
+private:
+    using clock = std::chrono::steady_clock;
+    clock::time_point m_start;
+};
+
+///
+///@brief Returns the value of a --key=value argument.
+///
+///@param args arguments given to the suite
+///@param key name of the argument without the leading dashes
+///@param default_value returned if the argument is not given
+///@return size_t the value of the argument
+///
+static inline size_t
+arg_value(const Arguments& args, const std::string& key, size_t default_value) {
+    const std::string prefix = "--" + key + "=";
+    for (const auto& a : args) {
+        if (a.compare(0, prefix.size(), prefix) == 0) {
+            return std::stoul(a.substr(prefix.size()));
+        }
+    }
+    return default_value;
+}
+
+///
+///@brief Returns the value of a --key=value argument as a string.
+///
+///@param args arguments given to the suite
+///@param key name of the argument without the leading dashes
+///@param default_value returned if the argument is not given
+///@return std::string the value of the argument
+///
+static inline std::string
+arg_string(const Arguments& args, const std::string& key, const std::string& default_value) {
+    const std::string prefix = "--" + key + "=";
+    for (const auto& a : args) {
+        if (a.compare(0, prefix.size(), prefix) == 0) { return a.substr(prefix.size()); }
+    }
+    return default_value;
+}
+
+static inline size_t mpi_rank() {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    return size_t(rank);
+}
+
+static inline size_t mpi_size() {
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    return size_t(size);
+}
+
+static inline void mpi_wait() { MPI_Barrier(MPI_COMM_WORLD); }
+
+///
+///@brief Returns the maximum of a value over all ranks, e.g. the time of a collective operation.
+///
+///@param value local value
+///@return double maximum over MPI_COMM_WORLD
+///
+static inline double mpi_max(double value) {
+    double ret;
+    MPI_Allreduce(&value, &ret, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return ret;
+}
+
+///
+///@brief Returns the size of a file on disk.
+///
+///@param name name of the file
+///@return size_t size in bytes, zero if the file does not exist
+///
+static inline size_t file_size(const std::string& name) {
+    struct stat buffer;
+    if (stat(name.c_str(), &buffer) != 0) { return 0; }
+    return size_t(buffer.st_size);
+}
+
+///
+///@brief Summary of a set of timing samples.
+///
+///
+struct Statistics {
+    size_t count = 0;
+    double min = 0.0, mean = 0.0, p50 = 0.0, p90 = 0.0, p99 = 0.0, max = 0.0;
+};
+
+///
+///@brief Computes the nearest-rank percentiles, mean and extremes of samples.
+///
+///@param samples timing samples, e.g. the latency of every call in seconds
+///@return Statistics summary of the samples
+///
+static inline Statistics statistics(std::vector<double> samples) {
+    Statistics ret;
+    if (samples.empty()) { return ret; }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p) {
+        size_t rank = size_t(p / 100.0 * double(samples.size()) + 0.5);
+        rank        = std::min(std::max(rank, size_t(1)), samples.size());
+        return samples[rank - 1];
+    };
+    ret.count = samples.size();
+    ret.min   = samples.front();
+    ret.max   = samples.back();
+    ret.mean  = std::accumulate(samples.begin(), samples.end(), 0.0) / double(samples.size());
+    ret.p50   = percentile(50.0);
+    ret.p90   = percentile(90.0);
+    ret.p99   = percentile(99.0);
+    return ret;
+}
+
+///
+///@brief Calls op() iterations times and returns the duration of every call. The first calls,
+///       a tenth of the iterations, warm up caches and allocators and are not timed.
+///
+///@param iterations number of timed calls
+///@param op callable to time
+///@return std::vector<double> duration of every call in seconds
+///
+template <class Op> std::vector<double> sample_latency(size_t iterations, Op&& op) {
+    for (size_t i = 0; i < iterations / 10; ++i) { op(); }
+    std::vector<double> samples(iterations);
+    for (auto& s : samples) {
+        Timer timer;
+        op();
+        s = timer.elapsed();
+    }
+    return samples;
+}
+
+///
+///@brief Results of all suites of a run, written as JSON by the main program when --json=file
+///       is given. Only rank 0 records results.
+///
+///
+class Report {
+
+public:
+    using Metrics = std::vector<std::pair<std::string, double>>;
+
+    ///
+    ///@brief Records the metrics of a benchmark case.
+    ///
+    ///@param suite name of the suite
+    ///@param name name of the case
+    ///@param metrics metric names and values, e.g. {"MB/s", 1234.0}
+    ///
+    void add(const std::string& suite, const std::string& name, const Metrics& metrics) {
+        if (mpi_rank() != 0) { return; }
+        m_entries.push_back(Entry{suite, name, metrics});
+    }
+
+    ///
+    ///@brief Records the throughput and latency percentiles of a benchmark case.
+    ///
+    ///@param suite name of the suite
+    ///@param name name of the case
+    ///@param latency statistics of the time per operation in seconds
+    ///@param bytes bytes transferred per operation, zero if not an I/O operation
+    ///
+    void add(const std::string& suite,
+             const std::string& name,
+             const Statistics&  latency,
+             double             bytes = 0.0) {
+        Metrics metrics{{"count", double(latency.count)},
+                        {"ops_per_s", latency.mean > 0.0 ? 1.0 / latency.mean : 0.0},
+                        {"latency_min_s", latency.min},
+                        {"latency_mean_s", latency.mean},
+                        {"latency_p50_s", latency.p50},
+                        {"latency_p90_s", latency.p90},
+                        {"latency_p99_s", latency.p99},
+                        {"latency_max_s", latency.max}};
+        if (bytes > 0.0 && latency.mean > 0.0) {
+            metrics.emplace_back("MB_per_s", bytes / latency.mean / 1e6);
+        }
+        add(suite, name, metrics);
+    }
+
+    ///
+    ///@brief Writes the recorded results as a JSON document.
+    ///
+    ///@param fname name of the file
+    ///@param context top level key-value pairs describing the run, e.g. the number of ranks
+    ///@return bool true if the file was written
+    ///
+    bool write_json(const std::string&                                      fname,
+                    const std::vector<std::pair<std::string, std::string>>& context) const {
+        std::FILE* f = std::fopen(fname.c_str(), "w");
+        if (f == nullptr) { return false; }
+        std::fprintf(f, "{\n");
+        for (const auto& [key, value] : context) {
+            std::fprintf(f, "  \"%s\": \"%s\",\n", escape(key).c_str(), escape(value).c_str());
+        }
+        std::fprintf(f, "  \"results\": [");
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            const auto& e = m_entries[i];
+            std::fprintf(f,
+                         "%s\n    {\"suite\": \"%s\", \"case\": \"%s\"",
+                         i == 0 ? "" : ",",
+                         escape(e.suite).c_str(),
+                         escape(e.name).c_str());
+            for (const auto& [key, value] : e.metrics) {
+                std::fprintf(f, ", \"%s\": %.9g", escape(key).c_str(), value);
+            }
+            std::fprintf(f, "}");
+        }
+        std::fprintf(f, "\n  ]\n}\n");
+        std::fclose(f);
+        return true;
+    }
+
+private:
+    struct Entry {
+        std::string suite;
+        std::string name;
+        Metrics     metrics;
+    };
+    std::vector<Entry> m_entries;
+
+    static std::string escape(const std::string& s) {
+        std::string ret;
+        for (char c : s) {
+            if (c == '"' || c == '\\') { ret += '\\'; }
+            ret += c;
+        }
+        return ret;
+    }
+};
+
+///
+///@brief Returns the report of the run.
+///
+///@return Report& the report shared by all suites
+///
+inline Report& report() {
+    static Report r;
+    return r;
+}
+
+} // namespace H5WrapperBench
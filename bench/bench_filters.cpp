@@ -0,0 +1,181 @@
+#include <cmath>
+#include <cstdio>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Write throughput and file size of a smooth 3D field for different layouts and filter
+// pipelines. Every rank writes an n x n x n block of a (ranks * n) x n x n dataset collectively.
+//
+// H5WrapperBench filters [--n=128] [--reps=3]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+struct FilterCase {
+    std::string                                    name;
+    bool                                           quantized; // written as 16 bit integers
+    std::function<void(H5DatasetCreateProperty&)> setup;
+};
+
+std::vector<FilterCase> filter_cases(const std::vector<size_t>& chunk) {
+
+    auto chunked = [chunk](H5DatasetCreateProperty& p) { p.set_chunk(chunk); };
+
+    return {
+        {"contiguous", false, [](H5DatasetCreateProperty&) {}},
+        {"chunked", false, chunked},
+        {"deflate1",
+         false,
+         [=](H5DatasetCreateProperty& p) {
+             chunked(p);
+             p.set_deflate(1);
+         }},
+        {"deflate6",
+         false,
+         [=](H5DatasetCreateProperty& p) {
+             chunked(p);
+             p.set_deflate(6);
+         }},
+        {"shuffle+deflate6",
+         false,
+         [=](H5DatasetCreateProperty& p) {
+             chunked(p);
+             p.set_shuffle();
+             p.set_deflate(6);
+         }},
+        {"scaleoffset(d3)",
+         false,
+         [=](H5DatasetCreateProperty& p) {
+             chunked(p);
+             p.set_scaleoffset(H5Z_SO_FLOAT_DSCALE, 3);
+         }},
+        {"scaleoffset(d3)+deflate1",
+         false,
+         [=](H5DatasetCreateProperty& p) {
+             chunked(p);
+             p.set_scaleoffset(H5Z_SO_FLOAT_DSCALE, 3);
+             p.set_deflate(1);
+         }},
+        {"fletcher32",
+         false,
+         [=](H5DatasetCreateProperty& p) {
+             chunked(p);
+             p.set_fletcher32();
+         }},
+        {"nbit(int16)",
+         true,
+         [=](H5DatasetCreateProperty& p) {
+             chunked(p);
+             p.set_nbit();
+         }},
+    };
+}
+
+void run_filters(const Arguments& args) {
+
+    const size_t n    = arg_value(args, "n", 128);
+    const size_t reps = arg_value(args, "reps", 3);
+
+    const std::vector<size_t> global_dims{n * mpi_size(), n, n};
+    const std::vector<size_t> local_dims{n, n, n};
+    const std::vector<size_t> start{n * mpi_rank(), 0, 0};
+
+    std::vector<float> field(n * n * n);
+    std::vector<int>   quantized(field.size());
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            for (size_t k = 0; k < n; ++k) {
+                size_t gi      = start[0] + i;
+                size_t idx     = (i * n + j) * n + k;
+                field[idx]     = std::sin(0.05f * float(gi)) * std::cos(0.05f * float(j)) +
+                             0.01f * float(k);
+                quantized[idx] = int(std::lround(1000.f * field[idx]));
+            }
+        }
+    }
+
+    const auto   chunk     = H5DatasetCreateProperty::guess_chunk(global_dims, sizeof(float));
+    const double raw_bytes = double(field.size() * sizeof(float) * mpi_size());
+
+    if (mpi_rank() == 0) {
+        std::printf("filters: dims %zu x %zu x %zu, chunk %zu x %zu x %zu, %zu ranks\n",
+                    global_dims[0],
+                    global_dims[1],
+                    global_dims[2],
+                    chunk[0],
+                    chunk[1],
+                    chunk[2],
+                    mpi_size());
+        std::printf("%-26s %12s %12s %14s %8s\n", "case", "time [s]", "MB/s", "file [B]", "ratio");
+    }
+
+    const auto cases = filter_cases(chunk);
+    for (size_t ci = 0; ci < cases.size(); ++ci) {
+
+        const auto&       c     = cases[ci];
+        const std::string fname = "bench_filters_" + std::to_string(ci) + ".h5";
+
+        double total = 0.0;
+        for (size_t r = 0; r < reps; ++r) {
+
+            mpi_wait();
+            Timer timer;
+            {
+                auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+
+                auto file_dataspace = H5Dataspace::create(global_dims);
+                auto file_slab      = H5Hyperslab::select(file_dataspace, start, local_dims);
+                auto memory_space   = H5Dataspace::create(local_dims);
+
+                H5DatasetCreateProperty dcpl;
+                c.setup(dcpl);
+
+                H5DatasetTransferProperty transfer;
+                transfer.set_collective_mpi_io();
+
+                if (c.quantized) {
+                    auto dt = H5DatatypeCreator<int>::create();
+                    dt.set_precision(16);
+                    transfer.allow_type_conversion();
+                    auto ds = H5Dataset::create(
+                        hf, "field", dt, file_dataspace, H5LinkCreateProperty(), dcpl);
+                    ds.write(quantized.data(), memory_space, file_slab, transfer);
+                } else {
+                    auto ds = H5Dataset::create(hf,
+                                                "field",
+                                                H5DatatypeCreator<float>::create(),
+                                                file_dataspace,
+                                                H5LinkCreateProperty(),
+                                                dcpl);
+                    ds.write(field.data(), memory_space, file_slab, transfer);
+                }
+            }
+            total += mpi_max(timer.elapsed());
+        }
+
+        double time = total / double(reps);
+        size_t size = file_size(fname);
+        report().add("filters",
+                     c.name,
+                     {{"time_s", time},
+                      {"MB_per_s", raw_bytes / time / 1e6},
+                      {"file_bytes", double(size)},
+                      {"ratio", raw_bytes / double(size)}});
+        if (mpi_rank() == 0) {
+            std::printf("%-26s %12.4f %12.1f %14zu %8.2f\n",
+                        c.name.c_str(),
+                        time,
+                        raw_bytes / time / 1e6,
+                        size,
+                        raw_bytes / double(size));
+        }
+    }
+}
+
+Registration registration("filters", run_filters);
+
+} // namespace
@@ -0,0 +1,151 @@
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Aggregate collective write bandwidth for every combination of a set of MPI-IO hints. Every
+// rank writes --mb MiB of doubles to its own slab of a contiguous one dimensional dataset.
+// Every combination also runs with the file aligned to --align bytes (H5FileAccessProperty::
+// set_alignment), by default the block size of the file system, so that the dataset and with
+// it the slab of every rank start on a block or stripe boundary. Every repetition creates the
+// file and the dataset before the timer starts and times the write and the closing of the file.
+//
+// The hints to sweep are given as key:value,value;key:value,... e.g.
+//   --sweep=romio_cb_write:enable,disable;cb_nodes:1,4;striping_factor:8
+// The default sweeps romio_cb_write and cb_buffer_size.
+//
+// H5WrapperBench hints [--mb=64] [--reps=3] [--sweep=...] [--align=bytes]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+using Hint = std::pair<std::string, std::string>;
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> ret;
+    size_t                   begin = 0;
+    while (begin <= s.size()) {
+        size_t end = s.find(sep, begin);
+        if (end == std::string::npos) { end = s.size(); }
+        if (end > begin) { ret.push_back(s.substr(begin, end - begin)); }
+        begin = end + 1;
+    }
+    return ret;
+}
+
+// Cartesian product of the values of all keys
+std::vector<std::vector<Hint>> combinations(const std::string& sweep) {
+    std::vector<std::vector<Hint>> ret{{}};
+    for (const auto& entry : split(sweep, ';')) {
+        auto colon = entry.find(':');
+        if (colon == std::string::npos) { continue; }
+        auto key = entry.substr(0, colon);
+
+        std::vector<std::vector<Hint>> next;
+        for (const auto& combination : ret) {
+            for (const auto& value : split(entry.substr(colon + 1), ',')) {
+                next.push_back(combination);
+                next.back().emplace_back(key, value);
+            }
+        }
+        ret = std::move(next);
+    }
+    return ret;
+}
+
+std::string describe(const std::vector<Hint>& hints) {
+    if (hints.empty()) { return "(none)"; }
+    std::string ret;
+    for (const auto& [key, value] : hints) {
+        if (!ret.empty()) { ret += ' '; }
+        ret += key + "=" + value;
+    }
+    return ret;
+}
+
+void run_hints(const Arguments& args) {
+
+    const size_t      mb    = arg_value(args, "mb", 64);
+    const size_t      reps  = arg_value(args, "reps", 3);
+    const std::string sweep = arg_string(
+        args, "sweep", "romio_cb_write:automatic,enable,disable;cb_buffer_size:4194304,16777216");
+
+    const size_t n = mb * 1024 * 1024 / sizeof(double);
+
+    const std::vector<size_t> global_dims{n * mpi_size()};
+    const std::vector<size_t> local_dims{n};
+    const std::vector<size_t> start{n * mpi_rank()};
+
+    std::vector<double> data(n, double(mpi_rank()));
+    const double        total_bytes = double(n * sizeof(double) * mpi_size());
+
+    auto cases = combinations(sweep);
+    cases.insert(cases.begin(), std::vector<Hint>{}); // baseline without hints
+
+    if (mpi_rank() == 0) {
+        std::printf("hints: %zu MiB per rank, %zu ranks\n", mb, mpi_size());
+        std::printf("%-60s %12s %12s\n", "hints", "time [s]", "MB/s");
+    }
+
+    const std::string fname = "bench_hints.h5";
+    const size_t      align = arg_value(args, "align", H5File::file_system_block_size(fname));
+
+    for (size_t c = 0; c < 2 * cases.size(); ++c) {
+
+        const auto& hints   = cases[c / 2];
+        const bool  aligned = c % 2 == 1;
+
+        H5MpiInfo info;
+        for (const auto& [key, value] : hints) { info.set(key, value); }
+        H5FileAccessProperty fapl;
+        fapl.set_mpi(MPI_COMM_WORLD, info);
+        if (aligned) {
+            fapl.set_alignment(align, align);
+            fapl.set_meta_block_size(align);
+        }
+        const std::string name =
+            describe(hints) + (aligned ? " align=" + std::to_string(align) : "");
+
+        double total = 0.0;
+        for (size_t r = 0; r < reps; ++r) {
+            auto hf = H5File::create(
+                fname, H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+
+            auto file_dataspace = H5Dataspace::create(global_dims);
+            auto file_slab      = H5Hyperslab::select(file_dataspace, start, local_dims);
+            auto memory_space   = H5Dataspace::create(local_dims);
+
+            H5DatasetTransferProperty transfer;
+            transfer.set_collective_mpi_io();
+
+            auto ds = H5Dataset::create(
+                hf, "data", H5DatatypeCreator<double>::create(), file_dataspace);
+
+            mpi_wait();
+            Timer timer;
+            ds.write(data.data(), memory_space, file_slab, transfer);
+            ds.close();
+            hf.close();
+            total += mpi_max(timer.elapsed());
+        }
+
+        double time = total / double(reps);
+        report().add("hints", name, {{"time_s", time}, {"MB_per_s", total_bytes / time / 1e6}});
+        if (mpi_rank() == 0) {
+            std::printf("%-60s %12.4f %12.1f\n", name.c_str(), time, total_bytes / time / 1e6);
+        }
+    }
+
+    mpi_wait();
+    if (mpi_rank() == 0) { std::remove(fname.c_str()); }
+}
+
+Registration registration("hints", run_hints);
+
+} // namespace
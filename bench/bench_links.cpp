@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <string>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Time to list the links of a group with 10^3 .. 10^max soft links, using link_names() and
+// the previous per-index enumeration (nlinks() per iteration, two H5Lget_name_by_idx per link)
+// up to 10^max_baseline links.
+//
+// H5WrapperBench links [--max=5] [--max_baseline=4]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+std::vector<std::string> link_names_by_idx(const H5Location& loc) {
+
+    std::vector<std::string> names;
+
+    for (size_t i = 0; i < loc.nlinks(); i++) {
+
+        ssize_t size = 1 + H5Lget_name_by_idx(
+                               ~loc, ".", H5_INDEX_NAME, H5_ITER_INC, i, NULL, 0, H5P_DEFAULT);
+
+        char* name = new char[size_t(size)];
+
+        H5Lget_name_by_idx(
+            ~loc, ".", H5_INDEX_NAME, H5_ITER_INC, i, name, size_t(size), H5P_DEFAULT);
+
+        names.push_back(std::string(name));
+
+        delete[] name;
+    }
+    return names;
+}
+
+void run_links(const Arguments& args) {
+
+    const size_t max_exponent      = arg_value(args, "max", 5);
+    const size_t baseline_exponent = arg_value(args, "max_baseline", 4);
+
+    if (mpi_rank() == 0) {
+        std::printf("links: %zu ranks\n", mpi_size());
+        std::printf("%-10s %16s %16s\n", "links", "link_names [s]", "by_idx [s]");
+    }
+
+    size_t n_links = 1000;
+    for (size_t e = 3; e <= max_exponent; ++e, n_links *= 10) {
+
+        const std::string fname = "bench_links.h5";
+
+        auto hf    = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+        auto group = H5Group::create(hf, "links");
+        for (size_t i = 0; i < n_links; ++i) {
+            std::string name = "step_" + std::to_string(i);
+            H5Lcreate_soft("/target", ~group, name.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+        }
+
+        mpi_wait();
+        Timer  timer;
+        auto   names     = group.link_names();
+        double t_iterate = mpi_max(timer.elapsed());
+
+        double t_baseline = -1.0;
+        if (e <= baseline_exponent) {
+            mpi_wait();
+            timer.restart();
+            auto baseline = link_names_by_idx(group);
+            t_baseline    = mpi_max(timer.elapsed());
+            if (baseline != names) { std::printf("links: enumerations differ!\n"); }
+        }
+
+        Report::Metrics metrics{{"link_names_s", t_iterate}};
+        if (t_baseline >= 0.0) { metrics.emplace_back("by_idx_s", t_baseline); }
+        report().add("links", std::to_string(n_links), metrics);
+
+        if (mpi_rank() == 0) {
+            std::printf("%-10zu %16.6f ", names.size(), t_iterate);
+            if (t_baseline < 0.0) {
+                std::printf("%16s\n", "-");
+            } else {
+                std::printf("%16.6f\n", t_baseline);
+            }
+        }
+    }
+}
+
+Registration registration("links", run_links);
+
+} // namespace
@@ -0,0 +1,144 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Aggregate collective write throughput of the access patterns used by the tests, scaled up:
+//  - contiguous: every rank writes a contiguous slab of a one dimensional dataset
+//  - halo: every rank writes the interior of a two dimensional block with ghost layers to its
+//    part of a global array, i.e. a hyperslab of memory to a hyperslab of the file, once with
+//    the selections made by hand and once through H5DistributedArray
+//  - elements: every rank writes scattered elements (global index i * ranks + rank)
+// Every repetition creates the file and the dataset before the timer starts and times the write
+// and the closing of the file, which flushes it. Time per repetition is the maximum over the
+// ranks, MB/s counts the bytes of all ranks. The files are removed after every case.
+//
+// H5WrapperBench macro [--n=1048576] [--elements=65536] [--ghost=2] [--reps=5]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+// file and dataset written by a repetition
+struct Target {
+    H5File    file;
+    H5Dataset dataset;
+
+    void close() {
+        dataset.close();
+        file.close();
+    }
+};
+
+Target create_target(const std::string& fname, const std::vector<size_t>& dims) {
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+    auto ds = H5Dataset::create(
+        hf, "data", H5DatatypeCreator<double>::create(), H5Dataspace::create(dims));
+    return Target{hf, ds};
+}
+
+template <class Op>
+void run_case(const std::string&         name,
+              size_t                     reps,
+              double                     bytes,
+              const std::string&         fname,
+              const std::vector<size_t>& dims,
+              Op&&                       op) {
+
+    std::vector<double> samples;
+    for (size_t r = 0; r < reps; ++r) {
+        auto target = create_target(fname, dims);
+        mpi_wait();
+        Timer timer;
+        op(target.dataset);
+        target.close();
+        samples.push_back(mpi_max(timer.elapsed()));
+    }
+    mpi_wait();
+    if (mpi_rank() == 0) { std::remove(fname.c_str()); }
+
+    auto s = statistics(samples);
+    report().add("macro", name, s, bytes);
+    if (mpi_rank() == 0) {
+        std::printf("%-14s %12.4f %12.4f %12.4f %12.1f\n",
+                    name.c_str(),
+                    s.mean,
+                    s.p50,
+                    s.max,
+                    bytes / s.mean / 1e6);
+    }
+}
+
+void run_macro(const Arguments& args) {
+
+    const size_t n          = arg_value(args, "n", 1048576);
+    const size_t n_elements = arg_value(args, "elements", 65536);
+    const size_t ghost      = arg_value(args, "ghost", 2);
+    const size_t reps       = arg_value(args, "reps", 5);
+
+    const size_t rank  = mpi_rank();
+    const size_t ranks = mpi_size();
+
+    if (mpi_rank() == 0) {
+        std::printf("macro: %zu ranks, %zu reps\n", ranks, reps);
+        std::printf(
+            "%-14s %12s %12s %12s %12s\n", "case", "mean [s]", "p50 [s]", "max [s]", "MB/s");
+    }
+
+    auto transfer = H5DatasetTransferProperty::collective();
+
+    {
+        std::vector<double> data(n, double(rank));
+        const double              bytes = double(n * ranks * sizeof(double));
+        const std::vector<size_t> dims{n * ranks};
+        run_case("contiguous", reps, bytes, "bench_macro_contiguous.h5", dims, [&](auto& ds) {
+            auto slab = H5Hyperslab::select(ds.cached_dataspace(), {n * rank}, {n});
+            ds.write(data.data(), H5Dataspace::create({n}), slab, transfer);
+        });
+    }
+
+    {
+        // square interior block of about n elements per rank, ranks stacked along the first axis
+        size_t side = 1;
+        while ((side + 1) * (side + 1) <= n) { ++side; }
+        const std::vector<size_t> interior{side, side};
+        const std::vector<size_t> local{side + 2 * ghost, side + 2 * ghost};
+
+        std::vector<double>       data(local[0] * local[1], double(rank));
+        const double              bytes = double(side * side * ranks * sizeof(double));
+        const std::vector<size_t> dims{side * ranks, side};
+        run_case("halo", reps, bytes, "bench_macro_halo.h5", dims, [&](auto& ds) {
+            auto f_slab = H5Hyperslab::select(ds.cached_dataspace(), {side * rank, 0}, interior);
+            auto m_slab = H5Hyperslab::select(H5Dataspace::create(local), {ghost, ghost}, interior);
+            ds.write(data.data(), m_slab, f_slab, transfer);
+        });
+
+        // the same through H5DistributedArray, whose selections are made once up front
+        const H5DistributedArray<double, 2> array(
+            {side * ranks, side}, {side * rank, 0}, {side, side}, {ghost, ghost});
+        run_case("halo array", reps, bytes, "bench_macro_halo.h5", dims, [&](auto& ds) {
+            array.write(ds, data.data(), transfer);
+        });
+    }
+
+    {
+        std::vector<size_t> indices(n_elements);
+        for (size_t i = 0; i < n_elements; ++i) { indices[i] = i * ranks + rank; }
+        std::vector<double> data(n_elements, double(rank));
+
+        const double              bytes = double(n_elements * ranks * sizeof(double));
+        const std::vector<size_t> dims{n_elements * ranks};
+        run_case("elements", reps, bytes, "bench_macro_elements.h5", dims, [&](auto& ds) {
+            auto sel = H5Elements::select(ds.cached_dataspace(), n_elements, indices);
+            ds.write(data.data(), H5Dataspace::create({n_elements}), sel, transfer);
+        });
+    }
+}
+
+Registration registration("macro", run_macro);
+
+} // namespace
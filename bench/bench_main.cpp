@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <hdf5.h>
+#include <mpi.h>
+
+#include "bench_common.hpp"
+
+// Usage: H5WrapperBench [suite ...] [--key=value ...] [--json=results.json]
+// Runs the named suites, or all registered suites if none are given, and optionally writes the
+// recorded results as JSON.
+int main(int argc, char* argv[]) {
+
+    MPI_Init(&argc, &argv);
+
+    using namespace H5WrapperBench;
+
+    std::vector<std::string> names;
+    Arguments                args;
+    for (int i = 1; i < argc; ++i) {
+        std::string a(argv[i]);
+        if (a.compare(0, 2, "--") == 0) {
+            args.push_back(a);
+        } else {
+            names.push_back(a);
+        }
+    }
+
+    if (names.empty()) {
+        for (const auto& [name, suite] : suites()) { names.push_back(name); }
+    }
+
+    int result = 0;
+    for (const auto& name : names) {
+        auto it = suites().find(name);
+        if (it == suites().end()) {
+            if (mpi_rank() == 0) {
+                std::printf("Unknown suite '%s'. Available suites:\n", name.c_str());
+                for (const auto& s : suites()) { std::printf("  %s\n", s.first.c_str()); }
+            }
+            result = 1;
+            continue;
+        }
+        it->second(args);
+    }
+
+    const std::string json = arg_string(args, "json", "");
+    if (!json.empty() && mpi_rank() == 0) {
+        unsigned major, minor, release;
+        H5get_libversion(&major, &minor, &release);
+        const std::string version = std::to_string(major) + "." + std::to_string(minor) + "." +
+                                    std::to_string(release);
+
+        std::string suite_list;
+        for (const auto& name : names) { suite_list += (suite_list.empty() ? "" : " ") + name; }
+
+        if (!report().write_json(json,
+                                 {{"ranks", std::to_string(mpi_size())},
+                                  {"hdf5_version", version},
+                                  {"suites", suite_list}})) {
+            std::printf("Could not write '%s'.\n", json.c_str());
+            result = 1;
+        }
+    }
+
+    MPI_Finalize();
+    return result;
+}
@@ -0,0 +1,125 @@
+#include <algorithm> //std::max
+#include <cstdio>
+#include <string>
+#include <utility> //std::pair
+#include <vector>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// A hierarchy of one group per particle species and step, each holding a small dataset, walked
+// by a reader listing every group with link_names, opening every step group and reading its
+// dataset. The walk runs with the default metadata cache, with a cache of fixed size, with
+// eviction on close and with both. Besides the time, the hit rate of the metadata cache and the
+// largest size it reached (sampled after every species) are reported. Every rank works on its
+// own serially accessed file.
+//
+// H5WrapperBench metadata_cache [--species=100] [--steps=200] [--cache_kb=1024]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+constexpr size_t values = 16;
+
+struct Walk {
+    double time_s;
+    double hit_rate;
+    size_t peak_bytes;
+};
+
+Walk walk(const std::string& name, const H5FileAccessProperty& fapl, size_t n_steps) {
+    mpi_wait();
+    Timer timer;
+    auto  hf = H5File::open(name, H5File::AccessFlag::READ, fapl);
+    hf.reset_mdc_stats();
+
+    std::vector<double> data(values);
+    size_t              peak = 0;
+    for (const auto& species_name : hf.link_names()) {
+        auto   species = H5Group::open(hf, species_name);
+        size_t steps   = 0;
+        for (const auto& step_name : species.link_names()) {
+            H5Dataset::open(H5Group::open(species, step_name), "x").read(data.data());
+            ++steps;
+        }
+        Utils::runtime_assert(steps == n_steps, "metadata_cache bench: missing steps.");
+        peak = std::max(peak, hf.get_mdc_stats().current_size);
+    }
+    const double hit_rate = hf.get_mdc_stats().hit_rate;
+    hf.close();
+    return {mpi_max(timer.elapsed()), hit_rate, peak};
+}
+
+void run_metadata_cache(const Arguments& args) {
+
+    const size_t n_species = arg_value(args, "species", 100);
+    const size_t n_steps   = arg_value(args, "steps", 200);
+    const size_t cache     = arg_value(args, "cache_kb", 1024) << 10;
+
+    const std::string fname = "bench_metadata_cache_" + std::to_string(mpi_rank()) + ".h5";
+
+    H5FileAccessProperty serial;
+    serial.set_serial();
+    {
+        auto hf =
+            H5File::create(fname, H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), serial);
+        std::vector<double> data(values, 1.0);
+        for (size_t s = 0; s < n_species; ++s) {
+            auto species = H5Group::create(hf, "species_" + std::to_string(s));
+            for (size_t t = 0; t < n_steps; ++t) {
+                auto step = H5Group::create(species, "step_" + std::to_string(t));
+                H5Dataset::create(step,
+                                  "x",
+                                  H5DatatypeCreator<double>::create(),
+                                  H5Dataspace::create({values}))
+                    .write(data.data());
+            }
+        }
+    }
+
+    H5FileAccessProperty fixed = serial.copy();
+    fixed.set_metadata_cache(cache, cache, cache, false);
+    H5FileAccessProperty evict = serial.copy();
+    evict.set_evict_on_close();
+    H5FileAccessProperty both = fixed.copy();
+    both.set_evict_on_close();
+
+    const std::vector<std::pair<std::string, H5FileAccessProperty>> cases = {
+        {"default", serial},
+        {"fixed size", fixed},
+        {"evict on close", evict},
+        {"fixed + evict", both}};
+
+    if (mpi_rank() == 0) {
+        std::printf("metadata_cache: %zu species x %zu steps, %zu KB fixed cache, %zu ranks\n",
+                    n_species,
+                    n_steps,
+                    cache >> 10,
+                    mpi_size());
+        std::printf("%-16s %12s %10s %14s\n", "case", "walk [ms]", "hit rate", "peak [KB]");
+    }
+    for (const auto& [name, fapl] : cases) {
+        const auto r = walk(fname, fapl, n_steps);
+        report().add("metadata_cache",
+                     name,
+                     {{"time_s", r.time_s},
+                      {"hit_rate", r.hit_rate},
+                      {"peak_bytes", double(r.peak_bytes)}});
+        if (mpi_rank() == 0) {
+            std::printf("%-16s %12.3f %10.3f %14.1f\n",
+                        name.c_str(),
+                        r.time_s * 1e3,
+                        r.hit_rate,
+                        double(r.peak_bytes) / 1024.0);
+        }
+    }
+
+    std::remove(fname.c_str());
+}
+
+Registration registration("metadata_cache", run_metadata_cache);
+
+} // namespace
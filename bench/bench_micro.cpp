@@ -0,0 +1,190 @@
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Per-call overhead of the wrapper: handle creation and destruction (against the raw C calls,
+// with and without the identifier lookups a type-dispatched close needs), moves and views of
+// unique handles versus copies of reference counted ones, property list construction against the
+// shared defaults, hyperslab selection, memory dataspaces built per call against memory views,
+// per-step metadata stored as datasets against attributes, small versus large dataset writes and
+// reads into new versus pooled buffers. Every rank works on its own serially accessed file, so
+// the numbers do not include MPI-IO. Reports ops/s and latency percentiles per call.
+//
+// H5WrapperBench micro [--iters=10000] [--large=1048576] [--large_iters=20]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+void print(const std::string& name, const Statistics& s, double bytes = 0.0) {
+    if (mpi_rank() != 0) { return; }
+    std::printf("%-28s %12.0f %12.3f %12.3f %12.3f",
+                name.c_str(),
+                s.mean > 0.0 ? 1.0 / s.mean : 0.0,
+                s.p50 * 1e6,
+                s.p90 * 1e6,
+                s.p99 * 1e6);
+    if (bytes > 0.0) { std::printf(" %12.1f", bytes / s.mean / 1e6); }
+    std::printf("\n");
+}
+
+void record(const std::string& name, const std::vector<double>& samples, double bytes = 0.0) {
+    auto s = statistics(samples);
+    print(name, s, bytes);
+    report().add("micro", name, s, bytes);
+}
+
+void run_micro(const Arguments& args) {
+
+    const size_t iters       = arg_value(args, "iters", 10000);
+    const size_t large       = arg_value(args, "large", 1048576);
+    const size_t large_iters = arg_value(args, "large_iters", 20);
+
+    if (mpi_rank() == 0) {
+        std::printf("micro: %zu iterations, %zu ranks, results of rank 0\n", iters, mpi_size());
+        std::printf("%-28s %12s %12s %12s %12s %12s\n",
+                    "case",
+                    "ops/s",
+                    "p50 [us]",
+                    "p90 [us]",
+                    "p99 [us]",
+                    "MB/s");
+    }
+
+    const hsize_t dims[2] = {100, 100};
+
+    record("raw create+close", sample_latency(iters, [&dims]() {
+               hid_t id = H5Screate_simple(2, dims, nullptr);
+               H5Sclose(id);
+           }));
+
+    // what closing a handle cost before the close function was fixed per subclass
+    record("raw create+lookup+close", sample_latency(iters, [&dims]() {
+               hid_t id = H5Screate_simple(2, dims, nullptr);
+               if (H5Iis_valid(id) > 0 && H5Iget_type(id) == H5I_DATASPACE) { H5Sclose(id); }
+           }));
+
+    record("dataspace create+close",
+           sample_latency(iters, []() { auto s = H5Dataspace::create({100, 100}); }));
+
+    {
+        auto space = H5Dataspace::create({100, 100});
+        record("dataspace copy+destroy", sample_latency(iters, [&space]() {
+                   H5Dataspace copy(space);
+               }));
+    }
+
+    record("unique create+close", sample_latency(iters, [&dims]() {
+               H5UniqueDataspace s(H5Screate_simple(2, dims, nullptr));
+           }));
+
+    {
+        H5UniqueDataspace space(H5Dataspace::create({100, 100}));
+        record("unique move+view", sample_latency(iters, [&space]() {
+                   H5UniqueDataspace tmp(std::move(space));
+                   auto              view = tmp.view();
+                   space                  = std::move(tmp);
+               }));
+    }
+
+    record("property create+close",
+           sample_latency(iters, []() { H5DatasetTransferProperty p; }));
+
+    // validation of a wrapped identifier is a single class membership test
+    record("property wrap+close", sample_latency(iters, []() {
+               H5DatasetTransferProperty p(H5Pcreate(H5P_DATASET_XFER));
+           }));
+
+    {
+        volatile hid_t sink = 0;
+        record("property default", sample_latency(iters, [&sink]() {
+                   sink = ~default_property<H5DatasetTransferProperty>();
+               }));
+    }
+
+    {
+        auto space = H5Dataspace::create({100, 100});
+        record("hyperslab select", sample_latency(iters, [&space]() {
+                   auto slab = H5Hyperslab::select(space, {10, 10}, {50, 50});
+               }));
+    }
+
+    H5FileAccessProperty fapl;
+    fapl.set_serial();
+    const std::string fname = "bench_micro_" + std::to_string(mpi_rank()) + ".h5";
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+
+    {
+        double value = 1.0;
+        auto   ds    = H5Dataset::create(
+            hf, "small", H5DatatypeCreator<double>::create(), H5Dataspace::create({1}));
+        record("write 1 double",
+               sample_latency(iters, [&]() { ds.write(&value); }),
+               double(sizeof(double)));
+    }
+
+    {
+        // per-step metadata: three tiny datasets against attributes set one by one and batched
+        const std::map<std::string, double> step = {{"time", 1.0}, {"dt", 0.1}, {"cfl", 0.5}};
+        size_t                              n    = 0;
+        record("metadata as datasets", sample_latency(iters / 10, [&]() {
+                   auto g = H5Group::create(hf, "datasets_" + std::to_string(n++));
+                   for (const auto& [name, value] : step) {
+                       auto ds = H5Dataset::create(
+                           g, name, H5DatatypeCreator<double>::create(), H5DataspaceScalar());
+                       ds.write(&value);
+                   }
+               }));
+        record("metadata as attributes", sample_latency(iters / 10, [&]() {
+                   auto g = H5Group::create(hf, "attributes_" + std::to_string(n++));
+                   for (const auto& [name, value] : step) { g.set_attribute(name, value); }
+               }));
+        record("metadata batched", sample_latency(iters / 10, [&]() {
+                   auto g = H5Group::create(hf, "batched_" + std::to_string(n++));
+                   g.set_attributes(step);
+               }));
+    }
+
+    {
+        // 5x5 interior of a block padded with 2 ghost cells
+        std::vector<double> block(81, 1.0);
+        auto                file_space = H5Dataspace::create({10, 10});
+        auto                slab       = H5Hyperslab::select(file_space, {0, 5}, {5, 5});
+        auto                ds =
+            H5Dataset::create(hf, "padded", H5DatatypeCreator<double>::create(), file_space);
+        record("write block, dataspace", sample_latency(iters, [&]() {
+                   auto memory = H5Hyperslab::select(H5Dataspace::create({9, 9}), {2, 2}, {5, 5});
+                   ds.write(block.data(), memory, slab);
+               }));
+        record("write block, view", sample_latency(iters, [&]() {
+                   ds.write(H5MemoryView<const double>::block(block.data(), {9, 9}, {2, 2}, {5, 5}),
+                            slab);
+               }));
+    }
+
+    {
+        std::vector<double> data(large, 1.0);
+        auto                ds = H5Dataset::create(
+            hf, "large", H5DatatypeCreator<double>::create(), H5Dataspace::create({large}));
+        record("write " + std::to_string(large) + " doubles",
+               sample_latency(large_iters, [&]() { ds.write(data.data()); }),
+               double(large * sizeof(double)));
+        record("read_all",
+               sample_latency(large_iters, [&]() { auto b = ds.read_all<double>(); }),
+               double(large * sizeof(double)));
+        H5BufferPool pool;
+        record("read_all pooled",
+               sample_latency(large_iters, [&]() { auto b = ds.read_all<double>(pool); }),
+               double(large * sizeof(double)));
+    }
+}
+
+Registration registration("micro", run_micro);
+
+} // namespace
@@ -0,0 +1,184 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility> //std::pair
+#include <vector>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Files of many small datasets (16 ints each, in groups of 1000) written with the default file
+// space strategy and with paged aggregation, and then opened and scanned: listing every group,
+// opening every dataset and reading it. Paged files are scanned with and without a page buffer.
+// Besides the time, the number of read and write system calls is reported (Linux only), which
+// is what a parallel file system pays for per small access even when the local page cache
+// hides it. Every rank works on its own serially accessed file, as the page buffer is not
+// supported with MPI-IO before HDF5 1.14. The page buffer of older versions may read past the
+// end of a page while scanning (see H5FileAccessProperty::set_page_buffer_size), so there the
+// page buffer case only runs with --page_buffer=1.
+//
+// H5WrapperBench paging [--objects=50000] [--page=65536] [--buffer_mb=16] [--page_buffer=0|1]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+constexpr size_t group_size = 1000;
+constexpr size_t values     = 16;
+
+// read and write system calls of the process so far, zero where /proc/self/io is missing
+std::pair<size_t, size_t> io_calls() {
+    std::ifstream in("/proc/self/io");
+    std::string   key;
+    size_t        value;
+    size_t        reads = 0, writes = 0;
+    while (in >> key >> value) {
+        if (key == "syscr:") { reads = value; }
+        if (key == "syscw:") { writes = value; }
+    }
+    return {reads, writes};
+}
+
+double create_file(const std::string&          name,
+                   size_t                      n_objects,
+                   const H5FileCreateProperty& fcpl,
+                   const H5FileAccessProperty& fapl,
+                   size_t&                     write_calls) {
+    mpi_wait();
+    const size_t calls = io_calls().second;
+    Timer        timer;
+    auto         hf    = H5File::create(name, H5File::CreationFlag::TRUNCATE, fcpl, fapl);
+
+    std::vector<int> data(values, 1);
+    H5Group          group;
+    for (size_t i = 0; i < n_objects; ++i) {
+        if (i % group_size == 0) {
+            group = H5Group::create(hf, "g" + std::to_string(i / group_size));
+        }
+        auto ds = H5Dataset::create(group,
+                                    "d" + std::to_string(i % group_size),
+                                    H5DatatypeCreator<int>::create(),
+                                    H5Dataspace::create({values}));
+        ds.write(data.data());
+    }
+    group.close();
+    hf.close();
+    const double t = mpi_max(timer.elapsed());
+    write_calls    = io_calls().second - calls;
+    return t;
+}
+
+double scan_file(const std::string& name, const H5FileAccessProperty& fapl, size_t& read_calls) {
+    mpi_wait();
+    const size_t calls = io_calls().first;
+    Timer        timer;
+    auto         hf    = H5File::open(name, H5File::AccessFlag::READ, fapl);
+
+    std::vector<int> data(values);
+    for (const auto& group_name : hf.link_names()) {
+        auto group = H5Group::open(hf, group_name);
+        for (const auto& dataset_name : group.link_names()) {
+            H5Dataset::open(group, dataset_name).read(data.data());
+        }
+    }
+    hf.close();
+    const double t = mpi_max(timer.elapsed());
+    read_calls     = io_calls().first - calls;
+    return t;
+}
+
+size_t file_size(const std::string& name) {
+    H5FileAccessProperty fapl;
+    fapl.set_serial();
+    return H5File::open(name, H5File::AccessFlag::READ, fapl).get_filesize();
+}
+
+void run_paging(const Arguments& args) {
+
+    const size_t n_objects = arg_value(args, "objects", 50000);
+    const size_t page      = arg_value(args, "page", 65536);
+    const size_t buffer    = arg_value(args, "buffer_mb", 16) << 20;
+#if H5_VERSION_GE(1, 14, 0)
+    const bool page_buffer = arg_value(args, "page_buffer", 1) != 0;
+#else
+    const bool page_buffer = arg_value(args, "page_buffer", 0) != 0;
+#endif
+
+    const std::string prefix = "bench_paging_" + std::to_string(mpi_rank());
+    const std::string plain  = prefix + "_default.h5";
+    const std::string paged  = prefix + "_paged.h5";
+
+    H5FileAccessProperty serial;
+    serial.set_serial();
+
+    H5FileCreateProperty paged_fcpl;
+    paged_fcpl.set_paged_aggregation(page);
+    H5FileAccessProperty buffered = serial.copy();
+    buffered.set_page_buffer_size(buffer);
+
+    struct Result {
+        std::string name;
+        double      create_s;
+        double      scan_s;
+        size_t      write_calls;
+        size_t      read_calls;
+        size_t      bytes;
+    };
+
+    auto run_case = [&](const std::string&          name,
+                        const std::string&          fname,
+                        const H5FileCreateProperty& fcpl,
+                        const H5FileAccessProperty& fapl) {
+        Result r{name, 0.0, 0.0, 0, 0, 0};
+        r.create_s = create_file(fname, n_objects, fcpl, fapl, r.write_calls);
+        r.scan_s   = scan_file(fname, fapl, r.read_calls);
+        r.bytes    = file_size(fname);
+        std::remove(fname.c_str());
+        return r;
+    };
+
+    std::vector<Result> results = {run_case("default", plain, H5FileCreateProperty(), serial),
+                                   run_case("paged", paged, paged_fcpl, serial)};
+    if (page_buffer) {
+        results.push_back(run_case("paged + page buffer", paged, paged_fcpl, buffered));
+    }
+
+    if (mpi_rank() == 0) {
+        std::printf("paging: %zu objects, %zu byte pages, %zu MB page buffer, %zu ranks\n",
+                    n_objects,
+                    page,
+                    buffer >> 20,
+                    mpi_size());
+        std::printf("%-20s %11s %11s %9s %9s %9s\n",
+                    "case",
+                    "create [ms]",
+                    "scan [ms]",
+                    "writes",
+                    "reads",
+                    "size [MB]");
+    }
+    for (const auto& r : results) {
+        report().add("paging",
+                     r.name,
+                     {{"create_s", r.create_s},
+                      {"scan_s", r.scan_s},
+                      {"write_calls", double(r.write_calls)},
+                      {"read_calls", double(r.read_calls)},
+                      {"bytes", double(r.bytes)}});
+        if (mpi_rank() == 0) {
+            std::printf("%-20s %11.3f %11.3f %9zu %9zu %9.3f\n",
+                        r.name.c_str(),
+                        r.create_s * 1e3,
+                        r.scan_s * 1e3,
+                        r.write_calls,
+                        r.read_calls,
+                        double(r.bytes) / 1e6);
+        }
+    }
+}
+
+Registration registration("paging", run_paging);
+
+} // namespace
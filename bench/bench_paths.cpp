@@ -0,0 +1,71 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "h5wrapper.hpp"
+
+#include "bench_common.hpp"
+
+// Time of H5Group::exists over the variables of a restart file laid out as
+// /steps/step_<i>/var_<j>, with and without the path index of the file. The queries are repeated
+// --reps times, which is what a restart does when it checks every variable of every step.
+//
+// H5WrapperBench paths [--steps=100] [--vars=20] [--reps=5]
+
+namespace {
+
+using namespace H5Wrapper;
+using namespace H5WrapperBench;
+
+double time_queries(const H5Location& loc, const std::vector<std::string>& paths, size_t reps) {
+    mpi_wait();
+    Timer  timer;
+    size_t found = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        for (const auto& p : paths) { found += H5Group::exists(loc, p); }
+    }
+    double t = mpi_max(timer.elapsed());
+    if (found != reps * paths.size()) { std::printf("paths: missing paths!\n"); }
+    return t;
+}
+
+void run_paths(const Arguments& args) {
+
+    const size_t n_steps = arg_value(args, "steps", 100);
+    const size_t n_vars  = arg_value(args, "vars", 20);
+    const size_t reps    = arg_value(args, "reps", 5);
+
+    const std::string fname = "bench_paths.h5";
+
+    std::vector<std::string> paths;
+    {
+        auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+        for (size_t i = 0; i < n_steps; ++i) {
+            for (size_t j = 0; j < n_vars; ++j) {
+                paths.push_back("steps/step_" + std::to_string(i) + "/var_" + std::to_string(j));
+                H5Group::create(hf, paths.back());
+            }
+        }
+    }
+
+    auto   hf      = H5File::open(fname, H5File::AccessFlag::READ);
+    double t_plain = time_queries(hf, paths, reps);
+
+    hf.enable_path_index();
+    double t_index = time_queries(hf, paths, reps);
+
+    const double queries = double(reps * paths.size());
+    report().add("paths", "plain", {{"time_s", t_plain}, {"ops_per_s", queries / t_plain}});
+    report().add("paths", "path index", {{"time_s", t_index}, {"ops_per_s", queries / t_index}});
+
+    if (mpi_rank() == 0) {
+        std::printf("paths: %zu ranks, %zu queries\n", mpi_size(), reps * paths.size());
+        std::printf("%-12s %12s\n", "exists", "time [s]");
+        std::printf("%-12s %12.6f\n", "plain", t_plain);
+        std::printf("%-12s %12.6f\n", "path index", t_index);
+    }
+}
+
+Registration registration("paths", run_paths);
+
+} // namespace
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm> //std::min, std::max
+#include <string>
+#include <vector>
+
+#include "h5_dataset.hpp"
+#include "h5_dataspace.hpp"
+#include "h5_dataspace_hyperslab.hpp"
+#include "h5_datatype_creator.hpp"
+#include "h5_location.hpp"
+#include "h5_property.hpp"
+
+#include "runtime_assert.hpp"
+
+namespace H5Wrapper {
+
+///
+///@brief Appends rows to a dataset whose first dimension is unlimited. A row is a slab of the
+///       remaining dimensions. Rows are buffered in memory and written a whole buffer (by default
+///       one chunk) at a time, and the extent of the dataset grows geometrically, so appending a
+///       row costs an amortized constant number of HDF5 calls. The extent is trimmed to the number
+///       of appended rows on close.
+///
+///       Extending a dataset is collective in parallel, so all ranks have to append the same
+///       number of rows. The stream is intended for a single writer of a serial file.
+///
+///@tparam T element type, has to be convertible with H5DatatypeCreator
+///
+template <class T> class H5AppendStream {
+
+public:
+    using dims_array = std::vector<size_t>;
+
+    H5AppendStream() = default;
+
+    ///
+    ///@brief Creates a new extendible, chunked dataset and a stream appending to it.
+    ///
+    ///@param loc Location identifier
+    ///@param name Dataset name
+    ///@param row_dims Dimensions of a single row, empty for a one dimensional dataset of T.
+    ///@param chunk_rows Number of rows in a chunk and in the write buffer. Zero derives the chunk
+    /// shape from H5DatasetCreateProperty::guess_chunk.
+    ///@return H5AppendStream stream appending to the created dataset
+    ///
+    static H5AppendStream create(const H5Location&  loc,
+                                 const std::string& name,
+                                 const dims_array&  row_dims   = dims_array{},
+                                 size_t             chunk_rows = 0) {
+
+        dims_array dims{0};
+        dims_array max_dims{H5Dataspace::unlimited};
+        dims.insert(dims.end(), row_dims.begin(), row_dims.end());
+        max_dims.insert(max_dims.end(), row_dims.begin(), row_dims.end());
+
+        dims_array chunk = H5DatasetCreateProperty::guess_chunk(dims, sizeof(T));
+        if (chunk_rows > 0) { chunk[0] = chunk_rows; }
+
+        H5DatasetCreateProperty dcpl;
+        dcpl.set_chunk(chunk);
+
+        auto dataset = H5Dataset::create(loc,
+                                         name,
+                                         H5DatatypeCreator<T>::create(),
+                                         H5Dataspace::create(dims, max_dims),
+                                         H5LinkCreateProperty(),
+                                         dcpl);
+
+        return H5AppendStream(dataset, chunk[0]);
+    }
+
+    ///
+    ///@brief Opens a stream appending to an existing extendible dataset.
+    ///
+    ///@param loc Location identifier
+    ///@param name Dataset name
+    ///@param buffer_rows Number of rows buffered before writing. Zero uses the chunk size.
+    ///@return H5AppendStream stream appending after the existing rows of the dataset
+    ///
+    static H5AppendStream
+    open(const H5Location& loc, const std::string& name, size_t buffer_rows = 0) {
+        return H5AppendStream(H5Dataset::open(loc, name), buffer_rows);
+    }
+
+    ///
+    ///@brief Construct a stream appending to an extendible dataset.
+    ///
+    ///@param dataset Chunked dataset with an unlimited first dimension.
+    ///@param buffer_rows Number of rows buffered before writing. Zero uses the chunk size.
+    ///
+    explicit H5AppendStream(const H5Dataset& dataset, size_t buffer_rows = 0)
+        : m_dataset(dataset) {
+
+        auto dims = m_dataset.cached_dataspace().get_dimensions();
+        Utils::runtime_assert(!dims.empty(), "H5AppendStream requires a simple dataspace.");
+        Utils::runtime_assert(m_dataset.cached_dataspace().get_max_dimensions()[0] ==
+                                  H5Dataspace::unlimited,
+                              "H5AppendStream requires an unlimited first dimension.");
+
+        m_row_dims = dims_array(dims.begin() + 1, dims.end());
+        m_row_size = 1;
+        for (auto d : m_row_dims) { m_row_size *= d; }
+        Utils::runtime_assert(m_row_size > 0, "H5AppendStream rows can not be empty.");
+
+        m_written  = dims[0];
+        m_capacity = dims[0];
+
+        m_buffer_rows = buffer_rows;
+        if (m_buffer_rows == 0) {
+            auto chunk    = m_dataset.get_create_property().get_chunk();
+            m_buffer_rows = chunk.empty() ? 1 : chunk[0];
+        }
+        m_buffer.reserve(m_buffer_rows * m_row_size);
+    }
+
+    H5AppendStream(const H5AppendStream&) = delete;
+    H5AppendStream& operator=(const H5AppendStream&) = delete;
+
+    H5AppendStream(H5AppendStream&&) noexcept = default;
+    H5AppendStream& operator=(H5AppendStream&& other) noexcept {
+        if (this == &other) { return *this; }
+        close_quietly();
+        m_dataset      = std::move(other.m_dataset);
+        m_row_dims     = std::move(other.m_row_dims);
+        m_row_size     = other.m_row_size;
+        m_buffer_rows  = other.m_buffer_rows;
+        m_buffer       = std::move(other.m_buffer);
+        m_written      = other.m_written;
+        m_capacity     = other.m_capacity;
+        m_buffer_space = std::move(other.m_buffer_space);
+        return *this;
+    }
+
+    ///
+    ///@brief Flushes the buffered rows and trims the dataset to the appended rows. Errors are
+    ///       discarded, call close() first to see them.
+    ///
+    ///
+    ~H5AppendStream() { close_quietly(); }
+
+    ///
+    ///@brief Appends a single element to a one dimensional dataset.
+    ///
+    ///@param value element to append
+    ///
+    void append(const T& value) {
+        Utils::runtime_assert(m_row_size == 1, "H5AppendStream row size is not one.");
+        append(&value, 1);
+    }
+
+    ///
+    ///@brief Appends rows stored contiguously in memory.
+    ///
+    ///@param rows pointer to n_rows * row_size() elements
+    ///@param n_rows number of rows to append
+    ///
+    void append(const T* rows, size_t n_rows = 1) {
+        const size_t capacity = m_buffer_rows * m_row_size;
+        size_t       count    = n_rows * m_row_size;
+        while (count > 0) {
+            size_t n = std::min(count, capacity - m_buffer.size());
+            m_buffer.insert(m_buffer.end(), rows, rows + n);
+            rows += n;
+            count -= n;
+            if (m_buffer.size() == capacity) { flush(); }
+        }
+    }
+
+    ///
+    ///@brief Writes the buffered rows to the dataset.
+    ///
+    ///
+    void flush() {
+        if (m_buffer.empty()) { return; }
+        const size_t n_rows = m_buffer.size() / m_row_size;
+
+        const size_t required = m_written + n_rows;
+        if (required > m_capacity) {
+            m_capacity = std::max(required, 2 * m_capacity);
+            m_dataset.set_extent(extent(m_capacity));
+        }
+
+        dims_array start(m_row_dims.size() + 1, 0);
+        start[0] = m_written;
+
+        auto file_slab = H5Hyperslab::select(m_dataset.cached_dataspace(), start, extent(n_rows));
+
+        if (n_rows == m_buffer_rows) {
+            if (!m_buffer_space.is_valid()) {
+                m_buffer_space = H5Dataspace::create(extent(m_buffer_rows));
+            }
+            m_dataset.write(m_buffer.data(), m_buffer_space, file_slab);
+        } else {
+            m_dataset.write(m_buffer.data(), H5Dataspace::create(extent(n_rows)), file_slab);
+        }
+
+        m_written += n_rows;
+        m_buffer.clear();
+    }
+
+    ///
+    ///@brief Flushes the buffered rows, trims the extent of the dataset to the number of appended
+    ///       rows and closes the stream. Throws if the rows can not be written.
+    ///
+    ///
+    void close() {
+        flush();
+        if (m_capacity != m_written) {
+            m_dataset.set_extent(extent(m_written));
+            m_capacity = m_written;
+        }
+        m_buffer_space = H5Dataspace();
+        m_dataset      = H5Dataset();
+    }
+
+    ///
+    ///@brief Returns the number of rows appended, including the rows still in the buffer.
+    ///
+    ///@return size_t number of rows
+    ///
+    size_t size() const {
+        if (m_row_size == 0) { return m_written; }
+        return m_written + m_buffer.size() / m_row_size;
+    }
+
+    ///
+    ///@brief Returns the number of elements in a row.
+    ///
+    ///@return size_t number of elements
+    ///
+    size_t row_size() const { return m_row_size; }
+
+    ///
+    ///@brief Returns the number of rows written at a time.
+    ///
+    ///@return size_t number of rows
+    ///
+    size_t buffer_rows() const { return m_buffer_rows; }
+
+    ///
+    ///@brief Get the dataset appended to.
+    ///
+    ///@return const H5Dataset& the dataset
+    ///
+    const H5Dataset& dataset() const { return m_dataset; }
+
+private:
+    H5Dataset      m_dataset;
+    dims_array     m_row_dims;
+    size_t         m_row_size    = 0;
+    size_t         m_buffer_rows = 0;
+    std::vector<T> m_buffer;
+    size_t         m_written  = 0; // rows in the file
+    size_t         m_capacity = 0; // current extent of the first dimension
+    H5Dataspace    m_buffer_space; // memory dataspace of a full buffer
+
+    // for the destructor and the move assignment, which must not throw
+    void close_quietly() noexcept {
+        try {
+            if (m_dataset.is_valid()) { close(); }
+        } catch (...) {}
+    }
+
+    dims_array extent(size_t n_rows) const {
+        dims_array ret{n_rows};
+        ret.insert(ret.end(), m_row_dims.begin(), m_row_dims.end());
+        return ret;
+    }
+};
+
+} // namespace H5Wrapper
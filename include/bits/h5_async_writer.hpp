@@ -0,0 +1,394 @@
+#pragma once
+
+#include <hdf5.h>
+#include <mpi.h>
+
+#include <algorithm> //std::copy_n
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <iterator> //std::data, std::size
+#include <memory>
+#include <mutex>
+#include <stdexcept> //std::runtime_error
+#include <thread>
+#include <type_traits>
+#include <utility> //std::move
+#include <vector>
+
+#include "h5_buffer.hpp"
+#include "h5_dataset.hpp"
+#include "h5_dataspace.hpp"
+#include "h5_dataspace_all.hpp"
+#include "h5_library_lock.hpp"
+#include "h5_memory_view.hpp"
+#include "h5_property.hpp"
+#include "is_h5_convertible.hpp"
+
+namespace H5Wrapper {
+
+namespace detail {
+
+struct H5AsyncJob {
+    std::promise<void> promise;
+    size_t             bytes = 0;
+
+    virtual ~H5AsyncJob() = default;
+    virtual void run()    = 0;
+};
+
+template <class Buffer> struct H5AsyncWrite : H5AsyncJob {
+    H5Dataset                 dataset;
+    Buffer                    data;
+    H5Dataspace               file_space;
+    H5DatasetTransferProperty transfer_prop;
+    size_t                    count = 0;
+
+    void run() override {
+        if (count == 0) { return; }
+        if (~file_space == ~H5DataspaceAll()) {
+            dataset.write(std::data(data), H5DataspaceAll(), transfer_prop);
+        } else {
+            dataset.write(std::data(data), H5Dataspace::create({count}), file_space, transfer_prop);
+        }
+    }
+};
+
+} // namespace detail
+
+///
+///@brief Writes datasets on a dedicated I/O thread, so that the calling thread hands off a buffer
+///       and keeps computing while the data goes to disk. Every write returns a std::future which
+///       becomes ready once the data is written, and rethrows the error of a failed write. Writes
+///       are performed in submission order.
+///
+///       The buffer of a write is either moved into the writer or copied on submission into a
+///       buffer of the writer's pool, so it can be reused right away. Buffers handed back by
+///       completed writes are recycled, which gives double buffering without allocations: fill
+///       a buffer from make_buffer(), submit it, and fill the next one while the first is written.
+///       The bytes of queued and running writes are bounded by max_bytes(). A submission which
+///       would exceed the bound blocks until enough earlier writes have completed.
+///
+///       HDF5 calls are serialized by a process-wide lock held by the I/O thread for each write
+///       and taken by every HDF5 call of the wrapper, including copying or closing handles, so
+///       other threads keep using the wrapper while writes are in flight. Only their direct HDF5
+///       calls need library_lock(). Writes to files opened with MPI-IO additionally require MPI
+///       initialized with MPI_THREAD_MULTIPLE.
+///
+class H5AsyncWriter {
+
+public:
+    using dims_array = std::vector<size_t>;
+
+    static constexpr size_t default_max_bytes = size_t(256) << 20;
+
+    ///
+    ///@brief Starts the I/O thread.
+    ///
+    ///@param max_bytes Bound on the bytes of the buffers of queued and running writes
+    ///
+    explicit H5AsyncWriter(size_t max_bytes = default_max_bytes)
+        : m_max_bytes(max_bytes)
+        , m_pool(max_bytes)
+        , m_thread([this]() { run(); }) {}
+
+    H5AsyncWriter(const H5AsyncWriter&) = delete;
+    H5AsyncWriter& operator=(const H5AsyncWriter&) = delete;
+
+    ///
+    ///@brief Completes all submitted writes and stops the I/O thread.
+    ///
+    ///
+    ~H5AsyncWriter() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_work.notify_one();
+        m_thread.join();
+    }
+
+    ///
+    ///@brief Locks the process-wide mutex serializing HDF5 calls, for direct HDF5 calls of other
+    ///       threads while writes are in flight. The wrapper takes it in its own HDF5 calls.
+    ///
+    ///@return std::unique_lock<std::recursive_mutex> the held lock
+    ///
+    static std::unique_lock<std::recursive_mutex> library_lock() { return detail::library_lock(); }
+
+    ///
+    ///@brief Returns a buffer from the pool of the writer, e.g. the next buffer to fill and submit.
+    ///
+    ///@param dims dimensions of the buffer
+    ///@return H5Buffer<T> uninitialized buffer
+    ///
+    template <class T> H5Buffer<T> make_buffer(const dims_array& dims) const {
+        return H5Buffer<T>(dims, m_pool);
+    }
+
+    ///
+    ///@brief Writes a buffer, taking ownership of it.
+    ///
+    ///@param dataset Dataset to write to
+    ///@param buffer as many elements as selected by file_dataspace
+    ///@param file_dataspace selection in the dataset, the whole dataset by default
+    ///@param transfer_prop transfer property list
+    ///@return std::future<void> ready when the buffer is written
+    ///
+    template <class T>
+    std::future<void> write(const H5Dataset&                 dataset,
+                            H5Buffer<T>&&                    buffer,
+                            H5Dataspace                      file_dataspace = H5DataspaceAll(),
+                            const H5DatasetTransferProperty& transfer_prop =
+                                default_property<H5DatasetTransferProperty>()) {
+        return submit<T>(dataset, std::move(buffer), std::move(file_dataspace), transfer_prop);
+    }
+
+    ///
+    ///@brief Writes a vector, taking ownership of it.
+    ///
+    ///@param dataset Dataset to write to
+    ///@param data as many elements as selected by file_dataspace
+    ///@param file_dataspace selection in the dataset, the whole dataset by default
+    ///@param transfer_prop transfer property list
+    ///@return std::future<void> ready when the data is written
+    ///
+    template <class T, class A>
+    std::future<void> write(const H5Dataset&                 dataset,
+                            std::vector<T, A>&&              data,
+                            H5Dataspace                      file_dataspace = H5DataspaceAll(),
+                            const H5DatasetTransferProperty& transfer_prop =
+                                default_property<H5DatasetTransferProperty>()) {
+        return submit<T>(dataset, std::move(data), std::move(file_dataspace), transfer_prop);
+    }
+
+    ///
+    ///@brief Writes a copy of the data, taken on submission. The data can be modified as soon as
+    ///       the call returns.
+    ///
+    ///@param dataset Dataset to write to
+    ///@param data pointer to as many elements as selected by file_dataspace
+    ///@param count number of elements
+    ///@param file_dataspace selection in the dataset, the whole dataset by default
+    ///@param transfer_prop transfer property list
+    ///@return std::future<void> ready when the copy is written
+    ///
+    template <class T>
+    std::future<void> write_copy(const H5Dataset&                 dataset,
+                                 const T*                         data,
+                                 size_t                           count,
+                                 H5Dataspace                      file_dataspace = H5DataspaceAll(),
+                                 const H5DatasetTransferProperty& transfer_prop =
+                                     default_property<H5DatasetTransferProperty>()) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "H5AsyncWriter copies trivially copyable data only.");
+        reserve(count * sizeof(T));
+        H5Buffer<T> copy;
+        try {
+            copy = make_buffer<T>({count});
+        } catch (...) {
+            release(count * sizeof(T));
+            throw;
+        }
+        std::copy_n(data, count, copy.data());
+        return enqueue<T>(dataset, std::move(copy), std::move(file_dataspace), transfer_prop);
+    }
+
+    ///
+    ///@brief Writes a copy of a container, e.g. a std::vector, taken on submission.
+    ///
+    ///@param dataset Dataset to write to
+    ///@param data contiguous container of as many elements as selected by file_dataspace
+    ///@param file_dataspace selection in the dataset, the whole dataset by default
+    ///@param transfer_prop transfer property list
+    ///@return std::future<void> ready when the copy is written
+    ///
+    template <class C, std::enable_if_t<detail::is_contiguous_container_v<C>, int> = 0>
+    std::future<void> write_copy(const H5Dataset&                 dataset,
+                                 const C&                         data,
+                                 H5Dataspace                      file_dataspace = H5DataspaceAll(),
+                                 const H5DatasetTransferProperty& transfer_prop =
+                                     default_property<H5DatasetTransferProperty>()) {
+        return write_copy(
+            dataset, std::data(data), std::size(data), std::move(file_dataspace), transfer_prop);
+    }
+
+    ///
+    ///@brief Blocks until all submitted writes have completed.
+    ///
+    ///
+    void flush() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_pending == 0; });
+    }
+
+    ///
+    ///@brief Returns the bytes of the buffers of queued and running writes.
+    ///
+    ///@return size_t bytes in flight
+    ///
+    size_t bytes_in_flight() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bytes_in_flight;
+    }
+
+    size_t max_bytes() const { return m_max_bytes; }
+
+private:
+    size_t                                          m_max_bytes;
+    H5BufferPool                                    m_pool;
+    mutable std::mutex                              m_mutex;
+    std::condition_variable                         m_work;
+    std::condition_variable                         m_done;
+    std::deque<std::unique_ptr<detail::H5AsyncJob>> m_queue;
+    size_t                                          m_pending         = 0;
+    size_t                                          m_bytes_in_flight = 0;
+    bool                                            m_stop            = false;
+    std::thread                                     m_thread; // started last
+
+    ///
+    ///@brief Waits until the bytes fit into the bound and accounts for them. A write larger than
+    ///       the bound is admitted when nothing else is in flight.
+    ///
+    void reserve(size_t bytes) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&]() {
+            return m_bytes_in_flight == 0 || m_bytes_in_flight + bytes <= m_max_bytes;
+        });
+        m_bytes_in_flight += bytes;
+        ++m_pending;
+    }
+
+    void release(size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bytes_in_flight -= bytes;
+            --m_pending;
+        }
+        m_done.notify_all();
+    }
+
+    template <class T, class Buffer>
+    std::future<void> submit(const H5Dataset&                 dataset,
+                             Buffer&&                         data,
+                             H5Dataspace&&                    file_dataspace,
+                             const H5DatasetTransferProperty& transfer_prop) {
+        reserve(std::size(data) * sizeof(T));
+        return enqueue<T>(dataset, std::move(data), std::move(file_dataspace), transfer_prop);
+    }
+
+    // the bytes of the data are reserved
+    template <class T, class Buffer>
+    std::future<void> enqueue(const H5Dataset&                 dataset,
+                              Buffer&&                         data,
+                              H5Dataspace&&                    file_dataspace,
+                              const H5DatasetTransferProperty& transfer_prop) {
+        static_assert(is_h5_convertible_v<T>,
+                      "H5AsyncWriter element type has no H5DatatypeCreator.");
+        const size_t bytes = std::size(data) * sizeof(T);
+
+        auto job   = std::make_unique<detail::H5AsyncWrite<std::decay_t<Buffer>>>();
+        job->bytes = bytes;
+        job->data  = std::move(data);
+        job->count = std::size(job->data);
+        auto ret   = job->promise.get_future();
+        try {
+            auto lock = library_lock();
+            // released under the lock, also if a check fails
+            H5Dataspace selection = std::move(file_dataspace);
+            detail::memory_type<T>();
+            // checked in every build, as the write runs on another thread where a mismatch
+            // would overrun the buffer
+            if (job->count != selected_count(dataset, selection)) {
+                throw std::runtime_error("H5AsyncWriter buffer size does not match the selection.");
+            }
+            if (!thread_safe_driver(dataset)) {
+                throw std::runtime_error(
+                    "H5AsyncWriter requires MPI_THREAD_MULTIPLE for MPI-IO files.");
+            }
+            job->dataset       = dataset;
+            job->transfer_prop = transfer_prop;
+            if (~selection != ~H5DataspaceAll()) {
+                // a selection still held by the caller may be changed, so the job takes a copy
+                job->file_space = H5Iget_ref(~selection) > 1
+                                      ? H5Dataspace(selection.clone_handle())
+                                      : std::move(selection);
+            }
+        } catch (...) {
+            {
+                auto lock = library_lock();
+                job.reset();
+            }
+            release(bytes);
+            throw;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(job));
+        }
+        m_work.notify_one();
+        return ret;
+    }
+
+    static size_t selected_count(const H5Dataset& dataset, const H5Dataspace& file_dataspace) {
+        hssize_t n = ~file_dataspace == ~H5DataspaceAll()
+                         ? H5Sget_simple_extent_npoints(~dataset.cached_dataspace())
+                         : H5Sget_select_npoints(~file_dataspace);
+        if (n < 0) { throw std::runtime_error("H5AsyncWriter selected_count fails."); }
+        return size_t(n);
+    }
+
+    static bool thread_safe_driver([[maybe_unused]] const H5Dataset& dataset) {
+#ifdef H5_HAVE_PARALLEL
+        hid_t file = H5Iget_file_id(~dataset);
+        if (file < 0) { throw std::runtime_error("H5AsyncWriter get_file_id fails."); }
+        hid_t fapl = H5Fget_access_plist(file);
+        H5Fclose(file);
+        if (fapl < 0) { throw std::runtime_error("H5AsyncWriter get_access_plist fails."); }
+        hid_t driver = H5Pget_driver(fapl);
+        H5Pclose(fapl);
+        if (driver < 0) { throw std::runtime_error("H5AsyncWriter get_driver fails."); }
+        if (driver == H5FD_MPIO) {
+            int level;
+            MPI_Query_thread(&level);
+            return level == MPI_THREAD_MULTIPLE;
+        }
+#endif
+        return true;
+    }
+
+    void run() {
+        for (;;) {
+            std::unique_ptr<detail::H5AsyncJob> job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_work.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+                if (m_queue.empty()) { return; }
+                job = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            auto               promise = std::move(job->promise);
+            const size_t       bytes   = job->bytes;
+            std::exception_ptr error;
+            {
+                // the handles held by the job are closed under the lock as well
+                auto lock = library_lock();
+                try {
+                    job->run();
+                } catch (...) { error = std::current_exception(); }
+                job.reset();
+            }
+
+            if (error) {
+                promise.set_exception(error);
+            } else {
+                promise.set_value();
+            }
+            release(bytes);
+        }
+    }
+};
+
+} // namespace H5Wrapper
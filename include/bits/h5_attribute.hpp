@@ -0,0 +1,378 @@
+#pragma once
+
+#include <hdf5.h>
+
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "h5_dataspace.hpp"
+#include "h5_dataspace_scalar.hpp"
+#include "h5_datatype.hpp"
+#include "h5_datatype_creator.hpp"
+#include "h5_object.hpp"
+#include "h5_property.hpp"
+#include "is_h5_convertible.hpp"
+
+#include "runtime_assert.hpp"
+
+namespace H5Wrapper {
+
+namespace detail {
+
+template <class T> struct is_std_vector : std::false_type {};
+template <class T, class A> struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+static inline herr_t
+collect_attribute_name(hid_t, const char* name, const H5A_info_t*, void* op_data) {
+    static_cast<std::vector<std::string>*>(op_data)->emplace_back(name);
+    return 0;
+}
+
+///
+///@brief Returns the names of the attributes of an object in increasing name order.
+///
+///@param obj object identifier
+///@return std::vector<std::string> attribute names
+///
+static inline std::vector<std::string> attribute_names(hid_t obj) {
+    auto                     lock = detail::library_lock();
+    std::vector<std::string> ret;
+    herr_t                   err =
+        H5Aiterate2(obj, H5_INDEX_NAME, H5_ITER_INC, nullptr, collect_attribute_name, &ret);
+    Utils::runtime_assert(err >= 0, "H5Aiterate fails.");
+    return ret;
+}
+
+///
+///@brief Returns a fixed-length string type holding a string of the given length and the
+///       terminating null character.
+///
+///@param length string length
+///@return H5Datatype string datatype
+///
+static inline H5Datatype string_type(size_t length) {
+    return H5DatatypeCreator<std::string>::create(length + 1);
+}
+
+} // namespace detail
+
+///
+///@brief Attribute handle. Attributes are small pieces of metadata stored in the object header of
+///       a group, dataset or named datatype, e.g. the time, time step and iteration of a snapshot.
+///       Reads and writes convert between the memory datatype of H5DatatypeCreator<T> and the
+///       datatype of the attribute.
+///
+class H5Attribute : public H5Object {
+
+public:
+    H5Attribute() = default;
+
+    ///
+    ///@brief Creates an attribute attached to an object.
+    ///
+    ///@param parent Group, dataset or named datatype the attribute is attached to
+    ///@param name Attribute name
+    ///@param type Datatype of the attribute
+    ///@param space Dataspace of the attribute
+    ///@param acpl Attribute creation property list
+    ///@return H5Attribute the created attribute
+    ///
+    static H5Attribute create(const H5Object&                  parent,
+                              const std::string&               name,
+                              const H5Datatype&                type,
+                              const H5Dataspace&               space,
+                              const H5AttributeCreateProperty& acpl =
+                                  default_property<H5AttributeCreateProperty>()) {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Acreate2(~parent, name.c_str(), ~type, ~space, ~acpl, H5P_DEFAULT);
+        Utils::runtime_assert(id >= 0, "H5Attribute create fails.");
+        return H5Attribute(id);
+    }
+
+    ///
+    ///@brief Opens an attribute attached to an object.
+    ///
+    ///@param parent Object the attribute is attached to
+    ///@param name Attribute name
+    ///@return H5Attribute the opened attribute
+    ///
+    static H5Attribute open(const H5Object& parent, const std::string& name) {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Aopen(~parent, name.c_str(), H5P_DEFAULT);
+        Utils::runtime_assert(id >= 0, "H5Attribute open fails.");
+        return H5Attribute(id);
+    }
+
+    ///
+    ///@brief Checks if an object has an attribute.
+    ///
+    ///@param parent Object to query
+    ///@param name Attribute name
+    ///@return true if the attribute exists
+    ///
+    static bool exists(const H5Object& parent, const std::string& name) {
+        auto   lock = detail::library_lock();
+        htri_t ret  = H5Aexists(~parent, name.c_str());
+        Utils::runtime_assert(ret >= 0, "H5Attribute exists fails.");
+        return ret > 0;
+    }
+
+    ///
+    ///@brief Deletes an attribute from an object.
+    ///
+    ///@param parent Object the attribute is attached to
+    ///@param name Attribute name
+    ///
+    static void remove(const H5Object& parent, const std::string& name) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Adelete(~parent, name.c_str());
+        Utils::runtime_assert(err >= 0, "H5Attribute remove fails.");
+    }
+
+    ///
+    ///@brief Closes the attribute.
+    ///
+    ///
+    void close() { H5Object::close(); }
+
+    ///
+    ///@brief Writes the whole attribute.
+    ///
+    ///@param buffer as many elements as the dataspace of the attribute holds
+    ///
+    template <class T> void write(const T* buffer) const {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Awrite(this->get_handle(), memory_datatype<T>(), buffer);
+        Utils::runtime_assert(err >= 0, "H5Attribute write fails.");
+    }
+
+    ///
+    ///@brief Reads the whole attribute.
+    ///
+    ///@param buffer room for as many elements as the dataspace of the attribute holds
+    ///
+    template <class T> void read(T* buffer) const {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Aread(this->get_handle(), memory_datatype<T>(), buffer);
+        Utils::runtime_assert(err >= 0, "H5Attribute read fails.");
+    }
+
+    ///
+    ///@brief Reads a string attribute of fixed or variable length. Of an attribute holding
+    ///       several strings, the first one is returned.
+    ///
+    ///@return std::string the value
+    ///
+    std::string read_string() const {
+        auto lock = detail::library_lock();
+        auto type = get_datatype();
+        Utils::runtime_assert(H5Tget_class(~type) == H5T_STRING, "H5Attribute is not a string.");
+
+        if (H5Tis_variable_str(~type) > 0) {
+            // pointers to strings allocated by HDF5, freed here
+            std::vector<char*> values(get_element_count(), nullptr);
+            herr_t             err = H5Aread(this->get_handle(), ~type, values.data());
+            Utils::runtime_assert(err >= 0, "H5Attribute read fails.");
+            std::string ret = !values.empty() && values[0] ? values[0] : "";
+            for (char* value : values) { H5free_memory(value); }
+            return ret;
+        }
+
+        std::vector<char> buffer(get_element_count() * H5Tget_size(~type) + 1, '\0');
+        herr_t            err = H5Aread(this->get_handle(), ~type, buffer.data());
+        Utils::runtime_assert(err >= 0, "H5Attribute read fails.");
+        return std::string(buffer.data());
+    }
+
+    H5Dataspace get_dataspace() const {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Aget_space(this->get_handle());
+        Utils::runtime_assert(id >= 0, "H5Attribute get_dataspace fails.");
+        return H5Dataspace(id);
+    }
+
+    H5Datatype get_datatype() const {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Aget_type(this->get_handle());
+        Utils::runtime_assert(id >= 0, "H5Attribute get_datatype fails.");
+        return H5Datatype(id);
+    }
+
+    ///
+    ///@brief Returns the number of elements of the attribute.
+    ///
+    ///@return size_t number of elements, one for a scalar attribute
+    ///
+    size_t get_element_count() const {
+        auto     lock  = detail::library_lock();
+        auto     space = get_dataspace();
+        hssize_t n     = H5Sget_simple_extent_npoints(~space);
+        Utils::runtime_assert(n >= 0, "H5Attribute get_element_count fails.");
+        return size_t(n);
+    }
+
+private:
+    explicit H5Attribute(hid_t id)
+        : H5Object(id, &H5Aclose) {}
+
+    template <class T> hid_t memory_datatype() const {
+        static_assert(is_h5_convertible_v<T>, "H5Attribute element type has no H5DatatypeCreator.");
+        return detail::memory_type<T>();
+    }
+};
+
+///
+///@brief Attribute interface of groups, files and datasets. Scalars of any type with an
+///       H5DatatypeCreator, std::vector of them and std::string are supported. Setting an
+///       attribute which already exists overwrites it, recreating it if the type or size changed.
+///
+///       Objects with many attributes should store them densely, see
+///       H5GroupCreateProperty::set_attribute_phase_change.
+///
+///@tparam Derived the object class, which has to derive from H5Object
+///
+template <class Derived> class H5AttributeHolder {
+
+public:
+    ///
+    ///@brief Creates or overwrites an attribute.
+    ///
+    ///@param name Attribute name
+    ///@param value Scalar, std::vector or string
+    ///
+    template <class T> void set_attribute(const std::string& name, const T& value) const {
+        set_attribute(name, value, H5Attribute::exists(object(), name));
+    }
+
+    ///
+    ///@brief Creates or overwrites many attributes in one pass. The existing attributes are
+    ///       listed once instead of being queried one by one, and attributes of the same shape
+    ///       share the dataspace.
+    ///
+    ///@param values Range of (name, value) pairs, e.g. a std::map<std::string, double>
+    ///
+    template <class Map> void set_attributes(const Map& values) const {
+        auto                            names = detail::attribute_names(~object());
+        std::unordered_set<std::string> existing(names.begin(), names.end());
+        H5DataspaceScalar               scalar;
+        for (const auto& [name, value] : values) {
+            set_attribute(name, value, existing.count(name) > 0, &scalar);
+        }
+    }
+
+    ///
+    ///@brief Reads an attribute.
+    ///
+    ///@tparam T Scalar, std::vector or std::string, the latter of fixed or variable length
+    ///@param name Attribute name
+    ///@return T the value
+    ///
+    template <class T> T get_attribute(const std::string& name) const {
+        auto   attribute = H5Attribute::open(object(), name);
+        size_t n         = attribute.get_element_count();
+        if constexpr (std::is_same_v<T, std::string>) {
+            return attribute.read_string();
+        } else if constexpr (detail::is_std_vector<T>::value) {
+            T ret(n);
+            attribute.read(ret.data());
+            return ret;
+        } else {
+            Utils::runtime_assert(n == 1, "H5Attribute is not a scalar.");
+            T ret;
+            attribute.read(&ret);
+            return ret;
+        }
+    }
+
+    ///
+    ///@brief Checks if an attribute exists.
+    ///
+    ///@param name Attribute name
+    ///@return true if the attribute exists
+    ///
+    bool has_attribute(const std::string& name) const {
+        return H5Attribute::exists(object(), name);
+    }
+
+    ///
+    ///@brief Deletes an attribute.
+    ///
+    ///@param name Attribute name
+    ///
+    void remove_attribute(const std::string& name) const { H5Attribute::remove(object(), name); }
+
+    ///
+    ///@brief Returns the names of all attributes.
+    ///
+    ///@return std::vector<std::string> attribute names in increasing order
+    ///
+    std::vector<std::string> attribute_names() const {
+        return detail::attribute_names(~object());
+    }
+
+private:
+    const H5Object& object() const { return static_cast<const Derived&>(*this); }
+
+    template <class T>
+    void set_attribute(const std::string& name,
+                       const T&           value,
+                       bool               exists,
+                       const H5Dataspace* scalar = nullptr) const {
+        if constexpr (std::is_convertible_v<const T&, std::string>) {
+            const std::string str(value);
+            auto              type = detail::string_type(str.size());
+            write_attribute(name, type, scalar_space(scalar), str.c_str(), ~type, exists);
+        } else if constexpr (detail::is_std_vector<T>::value) {
+            using value_type = typename T::value_type;
+            auto type        = H5DatatypeCreator<value_type>::create();
+            write_attribute(name,
+                            type,
+                            H5Dataspace::create({value.size()}),
+                            value.data(),
+                            detail::memory_type<value_type>(),
+                            exists);
+        } else {
+            static_assert(is_h5_convertible_v<T>,
+                          "H5Attribute value type has no H5DatatypeCreator.");
+            hid_t mem_type = detail::memory_type<T>();
+            write_attribute(name,
+                            H5Datatype(mem_type, H5Object::borrowed),
+                            scalar_space(scalar),
+                            &value,
+                            mem_type,
+                            exists);
+        }
+    }
+
+    static H5Dataspace scalar_space(const H5Dataspace* scalar) {
+        return scalar ? *scalar : H5DataspaceScalar();
+    }
+
+    void write_attribute(const std::string& name,
+                         const H5Datatype&  type,
+                         const H5Dataspace& space,
+                         const void*        buffer,
+                         hid_t              mem_type,
+                         bool               exists) const {
+        auto lock = detail::library_lock();
+        if (exists) {
+            auto attribute = H5Attribute::open(object(), name);
+            auto old_space = attribute.get_dataspace();
+            auto old_type  = attribute.get_datatype();
+            if (H5Tequal(~old_type, ~type) > 0 && H5Sextent_equal(~old_space, ~space) > 0) {
+                herr_t err = H5Awrite(~attribute, mem_type, buffer);
+                Utils::runtime_assert(err >= 0, "H5Attribute write fails.");
+                return;
+            }
+            attribute.close();
+            H5Attribute::remove(object(), name);
+        }
+        auto   attribute = H5Attribute::create(object(), name, type, space);
+        herr_t err       = H5Awrite(~attribute, mem_type, buffer);
+        Utils::runtime_assert(err >= 0, "H5Attribute write fails.");
+    }
+};
+
+} // namespace H5Wrapper
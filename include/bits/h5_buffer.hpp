@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new> //std::align_val_t
+#include <type_traits>
+#include <unordered_map>
+#include <utility> //std::exchange
+#include <vector>
+
+#include "h5_memory_view.hpp"
+
+#include "runtime_assert.hpp"
+
+namespace H5Wrapper {
+
+namespace detail {
+
+///
+///@brief Alignment of the buffers allocated by the wrapper, the width of a cache line and of the
+///       widest vector registers.
+///
+static constexpr size_t buffer_alignment = 64;
+
+static inline size_t aligned_size(size_t bytes) {
+    return (bytes + buffer_alignment - 1) / buffer_alignment * buffer_alignment;
+}
+
+static inline void* aligned_allocate(size_t bytes) {
+    return ::operator new(bytes, std::align_val_t(buffer_alignment));
+}
+
+static inline void aligned_free(void* ptr) {
+    ::operator delete(ptr, std::align_val_t(buffer_alignment));
+}
+
+struct H5BufferPoolState {
+    std::mutex                                      mutex;
+    std::unordered_map<size_t, std::vector<void*>> blocks; // free blocks by size in bytes
+    size_t                                          cached_bytes = 0;
+    size_t                                          max_cached_bytes;
+
+    explicit H5BufferPoolState(size_t max_cached)
+        : max_cached_bytes(max_cached) {}
+
+    ~H5BufferPoolState() {
+        for (auto& [bytes, list] : blocks) {
+            for (void* ptr : list) { aligned_free(ptr); }
+        }
+    }
+};
+
+} // namespace detail
+
+///
+///@brief Standard allocator returning memory aligned to 64 bytes, e.g. for a std::vector read
+///       with H5Dataset::read_all.
+///
+///@tparam T element type
+///
+template <class T> struct H5AlignedAllocator {
+    using value_type = T;
+
+    H5AlignedAllocator() = default;
+    template <class U> H5AlignedAllocator(const H5AlignedAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(detail::aligned_allocate(detail::aligned_size(n * sizeof(T))));
+    }
+    void deallocate(T* ptr, size_t) noexcept { detail::aligned_free(ptr); }
+
+    template <class U> bool operator==(const H5AlignedAllocator<U>&) const { return true; }
+    template <class U> bool operator!=(const H5AlignedAllocator<U>&) const { return false; }
+};
+
+///
+///@brief Pool of aligned memory blocks for H5Buffer. A buffer allocated from the pool hands its
+///       block back when it is destroyed, and the next buffer of the same size in bytes reuses
+///       it instead of allocating, so reading same-shaped fields over and over does not touch the
+///       heap. Copies of a pool share the blocks, which are freed when the pool and every buffer
+///       allocated from it are gone, or by clear(). A block which would grow the cached bytes
+///       beyond max_cached_bytes() is freed instead. Safe to share between threads.
+///
+class H5BufferPool {
+
+public:
+    static constexpr size_t default_max_cached_bytes = size_t(256) << 20;
+
+    ///
+    ///@brief Creates an empty pool.
+    ///
+    ///@param max_cached_bytes bound on the bytes of the blocks kept for reuse
+    ///
+    explicit H5BufferPool(size_t max_cached_bytes = default_max_cached_bytes)
+        : m_state(std::make_shared<detail::H5BufferPoolState>(max_cached_bytes)) {}
+
+    ///
+    ///@brief Frees all blocks not in use.
+    ///
+    ///
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        for (auto& [bytes, list] : m_state->blocks) {
+            for (void* ptr : list) { detail::aligned_free(ptr); }
+        }
+        m_state->blocks.clear();
+        m_state->cached_bytes = 0;
+    }
+
+    ///
+    ///@brief Returns the number of bytes in the blocks not in use.
+    ///
+    ///@return size_t cached bytes
+    ///
+    size_t cached_bytes() const {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->cached_bytes;
+    }
+
+    ///
+    ///@brief Returns the bound on the bytes of the blocks kept for reuse.
+    ///
+    ///@return size_t maximum cached bytes
+    ///
+    size_t max_cached_bytes() const { return m_state->max_cached_bytes; }
+
+private:
+    template <class T> friend class H5Buffer;
+
+    std::shared_ptr<detail::H5BufferPoolState> m_state;
+};
+
+///
+///@brief Owning, move-only buffer of elements with the dimensions of the dataset or selection it
+///       was read from. The memory is aligned to 64 bytes and is either allocated for the buffer
+///       or taken from an H5BufferPool. The elements are not initialized on construction.
+///
+///@tparam T element type, has to be trivially copyable
+///
+template <class T> class H5Buffer {
+
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "H5Buffer elements have to be trivially copyable.");
+
+public:
+    using dims_array = std::vector<size_t>;
+    using value_type = T;
+
+    static constexpr size_t alignment = detail::buffer_alignment;
+
+    H5Buffer() = default;
+
+    ///
+    ///@brief Allocates a buffer of the given dimensions.
+    ///
+    ///@param dims dimensions of the buffer
+    ///
+    explicit H5Buffer(const dims_array& dims)
+        : m_dims(dims)
+        , m_size(product(dims)) {
+        allocate();
+    }
+
+    ///
+    ///@brief Takes a buffer of the given dimensions from a pool.
+    ///
+    ///@param dims dimensions of the buffer
+    ///@param pool pool providing the memory
+    ///
+    H5Buffer(const dims_array& dims, const H5BufferPool& pool)
+        : m_dims(dims)
+        , m_size(product(dims))
+        , m_pool(pool.m_state) {
+        allocate();
+    }
+
+    H5Buffer(const H5Buffer&) = delete;
+    H5Buffer& operator=(const H5Buffer&) = delete;
+
+    H5Buffer(H5Buffer&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_dims(std::move(other.m_dims))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_pool(std::move(other.m_pool)) {}
+
+    H5Buffer& operator=(H5Buffer&& other) noexcept {
+        if (this != &other) {
+            deallocate();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_dims = std::move(other.m_dims);
+            m_size = std::exchange(other.m_size, 0);
+            m_pool = std::move(other.m_pool);
+        }
+        return *this;
+    }
+
+    ~H5Buffer() { deallocate(); }
+
+    T*                data() { return m_data; }
+    const T*          data() const { return m_data; }
+    size_t            size() const { return m_size; }
+    bool              empty() const { return m_size == 0; }
+    const dims_array& dims() const { return m_dims; }
+
+    T*       begin() { return m_data; }
+    T*       end() { return m_data + m_size; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+
+    T&       operator[](size_t i) { return m_data[i]; }
+    const T& operator[](size_t i) const { return m_data[i]; }
+
+    ///
+    ///@brief Returns a view of the buffer with its dimensions.
+    ///
+    ///@return H5MemoryView<T> contiguous view
+    ///
+    H5MemoryView<T> view() { return H5MemoryView<T>(m_data, m_dims); }
+
+private:
+    T*                                         m_data = nullptr;
+    dims_array                                 m_dims;
+    size_t                                     m_size = 0;
+    std::shared_ptr<detail::H5BufferPoolState> m_pool;
+
+    static size_t product(const dims_array& dims) {
+        size_t n = 1;
+        for (auto d : dims) { n *= d; }
+        return n;
+    }
+
+    size_t bytes() const { return detail::aligned_size(m_size * sizeof(T)); }
+
+    void allocate() {
+        if (m_size == 0) { return; }
+        const size_t n_bytes = bytes();
+        if (m_pool) {
+            std::lock_guard<std::mutex> lock(m_pool->mutex);
+            auto                        it = m_pool->blocks.find(n_bytes);
+            if (it != m_pool->blocks.end() && !it->second.empty()) {
+                m_data = static_cast<T*>(it->second.back());
+                it->second.pop_back();
+                m_pool->cached_bytes -= n_bytes;
+                return;
+            }
+        }
+        m_data = static_cast<T*>(detail::aligned_allocate(n_bytes));
+    }
+
+    void deallocate() noexcept {
+        if (m_data == nullptr) { return; }
+        if (m_pool) {
+            // the block is freed if the pool is full or can not record it
+            try {
+                const size_t                n_bytes = bytes();
+                std::lock_guard<std::mutex> lock(m_pool->mutex);
+                if (m_pool->cached_bytes + n_bytes <= m_pool->max_cached_bytes) {
+                    m_pool->blocks[n_bytes].push_back(m_data);
+                    m_pool->cached_bytes += n_bytes;
+                    m_data = nullptr;
+                    return;
+                }
+            } catch (...) {}
+        }
+        detail::aligned_free(m_data);
+        m_data = nullptr;
+    }
+};
+
+} // namespace H5Wrapper
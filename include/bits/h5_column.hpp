@@ -0,0 +1,185 @@
+#pragma once
+
+#include <hdf5.h>
+
+#include <algorithm> //std::min
+#include <cstring> //std::memcpy
+#include <iterator> //std::data, std::size
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "h5_datatype_compound.hpp"
+#include "h5_datatype_creator.hpp"
+#include "h5_memory_view.hpp"
+#include "is_h5_convertible.hpp"
+
+#include "runtime_assert.hpp"
+
+namespace H5Wrapper {
+
+///
+///@brief A field of a compound dataset held in memory as a separate array (structure of arrays),
+///       e.g. the x coordinates of all particles. Pairs the name of the compound member with a
+///       contiguous container of its values. The column does not own the memory.
+///
+class H5Column {
+
+public:
+    ///
+    ///@brief Construct a column read from and written to a container.
+    ///
+    ///@param name Name of the compound member
+    ///@param data Contiguous container, e.g. std::vector, of a type with an H5DatatypeCreator
+    ///
+    template <class C, std::enable_if_t<detail::is_contiguous_container_v<C>, int> = 0>
+    H5Column(const std::string& name, C& data)
+        : H5Column(name, std::data(data), std::size(data)) {}
+
+    ///
+    ///@brief Construct a column which can only be written.
+    ///
+    ///@param name Name of the compound member
+    ///@param data Contiguous container of a type with an H5DatatypeCreator
+    ///
+    template <class C, std::enable_if_t<detail::is_contiguous_container_v<C>, int> = 0>
+    H5Column(const std::string& name, const C& data)
+        : H5Column(name, std::data(data), std::size(data)) {}
+
+    const std::string& name() const { return m_name; }
+    size_t             size() const { return m_size; }
+    size_t             element_size() const { return m_element_size; }
+    hid_t              memory_type() const { return m_memory_type; }
+    bool               writable() const { return m_data != nullptr; }
+
+    ///
+    ///@brief Returns the values to be written.
+    ///
+    ///@return const unsigned char* the first byte of the values
+    ///
+    const unsigned char* data() const { return static_cast<const unsigned char*>(m_const_data); }
+
+    ///
+    ///@brief Returns the memory values are read into. Fails for columns of const containers.
+    ///
+    ///@return unsigned char* the first byte of the values
+    ///
+    unsigned char* target() const {
+        Utils::runtime_assert(m_data != nullptr, "H5Column of const values can not be read into.");
+        return static_cast<unsigned char*>(m_data);
+    }
+
+private:
+    std::string m_name;
+    void*       m_data         = nullptr; // null for const containers
+    const void* m_const_data   = nullptr;
+    size_t      m_size         = 0;
+    size_t      m_element_size = 0;
+    hid_t       m_memory_type  = H5I_INVALID_HID;
+
+    template <class T>
+    H5Column(const std::string& name, T* data, size_t size)
+        : m_name(name)
+        , m_const_data(data)
+        , m_size(size)
+        , m_element_size(sizeof(T))
+        , m_memory_type(detail::memory_type<std::remove_const_t<T>>()) {
+        static_assert(is_h5_convertible_v<std::remove_const_t<T>>,
+                      "H5Column element type has no H5DatatypeCreator.");
+        if constexpr (!std::is_const_v<T>) { m_data = data; }
+    }
+};
+
+namespace detail {
+
+///
+///@brief Packed memory compound of a set of columns, with the members in the order of the
+///       columns. Memory compounds naming only some members of the file compound transfer just
+///       those members.
+///
+struct H5ColumnLayout {
+    H5DatatypeCompound  type;
+    std::vector<size_t> offsets;
+    size_t              record_size = 0;
+
+    explicit H5ColumnLayout(const std::vector<H5Column>& columns) {
+        for (const auto& c : columns) {
+            offsets.push_back(record_size);
+            record_size += c.element_size();
+        }
+        type = H5DatatypeCompound::create(record_size);
+        for (size_t i = 0; i < columns.size(); ++i) {
+            H5Datatype member(columns[i].memory_type(), H5Object::borrowed);
+            type.insert(member, columns[i].name(), offsets[i]);
+        }
+    }
+
+    // records are interleaved in blocks small enough to stay in the L1 cache for all columns
+    static constexpr size_t block_records = 64;
+
+    ///
+    ///@brief Interleaves the columns into records.
+    ///
+    void gather(const std::vector<H5Column>& columns, unsigned char* records, size_t n) const {
+        for (size_t first = 0; first < n; first += block_records) {
+            const size_t count = std::min(block_records, n - first);
+            for (size_t c = 0; c < columns.size(); ++c) {
+                const size_t         size = columns[c].element_size();
+                const unsigned char* src  = columns[c].data() + first * size;
+                unsigned char*       dst  = records + first * record_size + offsets[c];
+                copy_strided(dst, record_size, src, size, size, count);
+            }
+        }
+    }
+
+    ///
+    ///@brief Splits records into the columns.
+    ///
+    void
+    scatter(const unsigned char* records, const std::vector<H5Column>& columns, size_t n) const {
+        for (size_t first = 0; first < n; first += block_records) {
+            const size_t count = std::min(block_records, n - first);
+            for (size_t c = 0; c < columns.size(); ++c) {
+                const size_t         size = columns[c].element_size();
+                const unsigned char* src  = records + first * record_size + offsets[c];
+                unsigned char*       dst  = columns[c].target() + first * size;
+                copy_strided(dst, size, src, record_size, size, count);
+            }
+        }
+    }
+
+private:
+    template <size_t Size>
+    static void copy_strided(unsigned char*       dst,
+                             size_t               dst_stride,
+                             const unsigned char* src,
+                             size_t               src_stride,
+                             size_t               n) {
+        for (size_t i = 0; i < n; ++i) {
+            std::memcpy(dst + i * dst_stride, src + i * src_stride, Size);
+        }
+    }
+
+    // fixed-size copies of the common element sizes compile to single loads and stores
+    static void copy_strided(unsigned char*       dst,
+                             size_t               dst_stride,
+                             const unsigned char* src,
+                             size_t               src_stride,
+                             size_t               size,
+                             size_t               n) {
+        switch (size) {
+        case 1: return copy_strided<1>(dst, dst_stride, src, src_stride, n);
+        case 2: return copy_strided<2>(dst, dst_stride, src, src_stride, n);
+        case 4: return copy_strided<4>(dst, dst_stride, src, src_stride, n);
+        case 8: return copy_strided<8>(dst, dst_stride, src, src_stride, n);
+        default:
+            for (size_t i = 0; i < n; ++i) {
+                std::memcpy(dst + i * dst_stride, src + i * src_stride, size);
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+} // namespace H5Wrapper
@@ -1,24 +1,89 @@
 #pragma once
 
 #include <hdf5.h>
+#include <memory> //std::shared_ptr
 #include <string>
+#include <type_traits>
+#include <utility> //std::move, std::pair
+#include <vector>
 
 #include "runtime_assert.hpp"
 
+#include "h5_attribute.hpp"
+#include "h5_buffer.hpp"
+#include "h5_column.hpp"
 #include "h5_dataspace.hpp"
 #include "h5_dataspace_all.hpp"
+#include "h5_dataspace_hyperslab.hpp"
 #include "h5_datatype.hpp"
+#include "h5_datatype_compound.hpp"
+#include "h5_datatype_creator.hpp"
+#include "h5_functions.hpp"
 #include "h5_location.hpp"
+#include "h5_memory_view.hpp"
 #include "h5_object.hpp"
 #include "h5_property.hpp"
+#include "is_h5_convertible.hpp"
 
 namespace H5Wrapper {
 
-class H5Dataset : public H5Object {
+///
+///@brief Dataset handle. The file dataspace and datatype are queried once when the dataset is
+///       created or opened and kept alongside the handle, so that read and write calls do not
+///       create any HDF5 objects of their own. Copies of a handle share them, so a new extent
+///       set through one copy is seen by all.
+///
+///       The templated read and write calls use the memory datatype given by
+///       H5DatatypeCreator<T> whenever one exists for T. If it differs from the file datatype,
+///       the transfer property list must explicitly allow type conversion. A compound with the
+///       same members in another layout, e.g. the packed file type of a struct, is always
+///       accepted.
+///
+///       Reads and writes of containers and H5MemoryView derive the memory dataspace from the
+///       shape of the memory. The dataspaces of the last few shapes are kept with the handle, so
+///       repeated transfers of the same shape do not create any dataspace.
+///
+class H5Dataset : public H5Object, public H5AttributeHolder<H5Dataset> {
+
+    struct Metadata;
 
 public:
+    ///
+    ///@brief Cache of the file dataspace and datatype, shared by the copies of a handle and by
+    ///       the views of an H5UniqueDataset.
+    ///
+    using SharedMetadata = std::shared_ptr<Metadata>;
+
     H5Dataset() = default;
 
+    ///
+    ///@brief Construct a non-owning view of a dataset owned elsewhere. The file dataspace and
+    ///       datatype are queried on the first transfer and cached like for an owning handle,
+    ///       so that a view costs no HDF5 call unless it is used.
+    ///
+    ///@param id dataset identifier
+    ///
+    H5Dataset(hid_t id, H5Object::Borrowed tag)
+        : H5Dataset(id, tag, make_metadata()) {}
+
+    ///
+    ///@brief Construct a non-owning view sharing the metadata cache of other views of the same
+    ///       dataset, so that it is queried once for all of them.
+    ///
+    ///@param id dataset identifier
+    ///@param metadata cache from make_metadata(), used for this identifier only
+    ///
+    H5Dataset(hid_t id, H5Object::Borrowed tag, SharedMetadata metadata)
+        : H5Object(id, tag)
+        , m_metadata(std::move(metadata)) {}
+
+    ///
+    ///@brief Returns an empty metadata cache, filled on the first transfer of a view using it.
+    ///
+    ///@return SharedMetadata the cache
+    ///
+    static SharedMetadata make_metadata() { return std::make_shared<Metadata>(); }
+
     ///
     ///@brief Creates a new dataset and links it into the file.
     ///
@@ -35,11 +100,18 @@ public:
                             const std::string&             name,
                             const H5Datatype&              type,
                             const H5Dataspace&             file_dataspace,
-                            const H5LinkCreateProperty&    link_prop  = H5LinkCreateProperty(),
-                            const H5DatasetCreateProperty& creat_prop = H5DatasetCreateProperty(),
-                            const H5DatasetAccessProperty& acc_prop   = H5DatasetAccessProperty()) {
+                            const H5LinkCreateProperty&    link_prop =
+                                default_property<H5LinkCreateProperty>(),
+                            const H5DatasetCreateProperty& creat_prop =
+                                default_property<H5DatasetCreateProperty>(),
+                            const H5DatasetAccessProperty& acc_prop =
+                                default_property<H5DatasetAccessProperty>()) {
 
-        return H5Dataset(loc, name, type, file_dataspace, link_prop, creat_prop, acc_prop);
+        H5Dataset dataset(loc, name, type, file_dataspace, link_prop, creat_prop, acc_prop);
+        if (loc.path_index()) {
+            loc.path_index()->insert_with_parents(loc.absolute_path(name), H5O_TYPE_DATASET);
+        }
+        return dataset;
     }
 
     ///
@@ -48,7 +120,8 @@ public:
     ///@return H5Dataspace dataspace used in creation of the dataset.
     ///
     H5Dataspace get_dataspace() const {
-        hid_t id = H5Dget_space(this->get_handle());
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Dget_space(this->get_handle());
         Utils::runtime_assert(id >= 0, "H5Dataset get_dataspace fails.");
         return H5Dataspace(id);
     }
@@ -59,11 +132,25 @@ public:
     ///@return H5Datatype datatype used in the creation of the dataset.
     ///
     H5Datatype get_datatype() const {
-        hid_t id = H5Dget_type(this->get_handle());
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Dget_type(this->get_handle());
         Utils::runtime_assert(id >= 0, "H5Dataspace get_datatype fails.");
         return H5Datatype(id);
     }
 
+    ///
+    ///@brief Get a copy of the dataset creation property list.
+    ///
+    ///@return H5DatasetCreateProperty creation properties (layout, chunking, filters) of the
+    /// dataset.
+    ///
+    H5DatasetCreateProperty get_create_property() const {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Dget_create_plist(this->get_handle());
+        Utils::runtime_assert(id >= 0, "H5Dataset get_create_property fails.");
+        return H5DatasetCreateProperty(id);
+    }
+
     ///
     ///@brief Opens an existing dataset.
     ///
@@ -74,92 +161,604 @@ public:
     ///
     static H5Dataset open(const H5Location&              loc,
                           const std::string&             name,
-                          const H5DatasetAccessProperty& acc_prop = H5DatasetAccessProperty()) {
-        hid_t id = H5Dopen(~loc, name.c_str(), ~acc_prop);
+                          const H5DatasetAccessProperty& acc_prop =
+                              default_property<H5DatasetAccessProperty>()) {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Dopen(~loc, name.c_str(), ~acc_prop);
         Utils::runtime_assert(id >= 0, "H5Dataset open fails.");
+        if (loc.path_index()) {
+            loc.path_index()->insert_with_parents(loc.absolute_path(name), H5O_TYPE_DATASET);
+        }
         return H5Dataset(id);
     }
 
+    ///
+    ///@brief Opens an existing dataset with its chunk cache sized for an access pattern, see
+    ///       H5DatasetAccessProperty::fit_chunk_cache. The chunk shape is only known once the
+    ///       dataset is open, so a chunked dataset is opened twice. Other layouts are opened
+    ///       with the given access property list unchanged.
+    ///
+    ///@param loc Location identifier
+    ///@param name Dataset name
+    ///@param pattern Shape of the selections the dataset is accessed with
+    ///@param acc_prop Dataset access property list, copied before the cache is set
+    ///@return H5Dataset Returns a dataset identifier if successful
+    ///
+    static H5Dataset open(const H5Location&              loc,
+                          const std::string&             name,
+                          const H5AccessPattern&         pattern,
+                          const H5DatasetAccessProperty& acc_prop =
+                              default_property<H5DatasetAccessProperty>()) {
+        auto lock  = detail::library_lock();
+        auto probe = open(loc, name, acc_prop);
+        auto chunk = probe.get_create_property().get_chunk();
+        if (chunk.empty()) { return probe; }
+
+        const auto   dims         = probe.cached_dataspace().get_dimensions();
+        const size_t element_size = probe.cached_datatype().get_size();
+        probe.close();
+
+        hid_t id = H5Pcopy(~acc_prop);
+        Utils::runtime_assert(id >= 0, "H5Dataset open copy access property fails.");
+        H5DatasetAccessProperty dapl(id);
+        dapl.fit_chunk_cache(dims, chunk, element_size, pattern);
+        return open(loc, name, dapl);
+    }
+
+    ///
+    ///@brief Get a copy of the dataset access property list.
+    ///
+    ///@return H5DatasetAccessProperty access properties, e.g. the chunk cache, of the dataset.
+    ///
+    H5DatasetAccessProperty get_access_property() const {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Dget_access_plist(this->get_handle());
+        Utils::runtime_assert(id >= 0, "H5Dataset get_access_property fails.");
+        return H5DatasetAccessProperty(id);
+    }
+
+    ///
+    ///@brief Returns the address of the data of a contiguous dataset in the file, e.g. to check
+    ///       its alignment (H5FileAccessProperty::set_alignment).
+    ///
+    ///@return size_t offset in bytes
+    ///
+    size_t get_file_offset() const {
+        auto    lock   = detail::library_lock();
+        haddr_t offset = H5Dget_offset(this->get_handle());
+        Utils::runtime_assert(offset != HADDR_UNDEF,
+                              "H5Dataset get_file_offset fails, the dataset is chunked or its "
+                              "storage is not allocated.");
+        return offset;
+    }
+
     ///
     ///@brief Closes an open dataset.
     ///
     ///
     void close() {
-        auto err = H5Dclose(this->get_handle());
-        Utils::runtime_assert(err >= 0, "H5Dataset close fails.");
+        m_metadata.reset();
+        m_memory_spaces.clear();
+        H5Object::close();
+    }
+
+    ///
+    ///@brief Re-reads the cached file dataspace and datatype. Copies of a handle share the
+    ///       cache, so this is only needed if the extent of the dataset has been changed through
+    ///       a handle opened separately, e.g. by another H5Dataset::open call.
+    ///
+    ///
+    void refresh_metadata() {
+        auto lock = detail::library_lock();
+        if (m_metadata) {
+            *m_metadata = Metadata(*this);
+        } else {
+            m_metadata = std::make_shared<Metadata>(*this);
+        }
     }
 
+    ///
+    ///@brief Changes the dimensions of a chunked dataset. The new dimensions may not exceed the
+    ///       maximum dimensions of the dataspace used in the creation of the dataset. Shrinking a
+    ///       dimension discards the data outside of the new extent. Collective in parallel.
+    ///
+    ///@param dims New dimensions of the dataset
+    ///
+    void set_extent(const std::vector<size_t>& dims) {
+        auto                 lock = detail::library_lock();
+        std::vector<hsize_t> c_dims(dims.begin(), dims.end());
+        herr_t               err = H5Dset_extent(this->get_handle(), c_dims.data());
+        Utils::runtime_assert(err >= 0, "H5Dataset set_extent fails.");
+        // seen by every copy of this handle
+        metadata().file_space = this->get_dataspace();
+    }
+
+    ///
+    ///@brief Grows the dimensions of a chunked dataset by the given increments.
+    ///
+    ///@param increment Number of elements to add to each dimension
+    ///
+    void extend(const std::vector<size_t>& increment) {
+        auto dims = cached_dataspace().get_dimensions();
+        Utils::runtime_assert(dims.size() == increment.size(), "H5Dataset extend rank mismatch.");
+        for (size_t i = 0; i < dims.size(); ++i) { dims[i] += increment[i]; }
+        set_extent(dims);
+    }
+
+    ///
+    ///@brief Get the cached dataspace of the dataset without querying the file.
+    ///
+    ///@return const H5Dataspace& dataspace of the dataset at the time of the last refresh.
+    ///
+    const H5Dataspace& cached_dataspace() const { return metadata().file_space; }
+
+    ///
+    ///@brief Get the cached datatype of the dataset without querying the file.
+    ///
+    ///@return const H5Datatype& datatype used in the creation of the dataset.
+    ///
+    const H5Datatype& cached_datatype() const { return metadata().file_type; }
+
     template <class T>
     void write(const T*                         buffer,
                const H5Dataspace&               memory_dataspace = H5DataspaceAll(),
-               const H5DatasetTransferProperty& transfer_prop = H5DatasetTransferProperty()) const {
-
-        H5Dataspace file_space = this->get_dataspace();
-        H5Datatype  file_dtype = this->get_datatype();
+               const H5DatasetTransferProperty& transfer_prop =
+                   default_property<H5DatasetTransferProperty>()) const {
+        auto lock = detail::library_lock();
 
         herr_t err = H5Dwrite(this->get_handle(),
-                              ~file_dtype,
+                              this->memory_datatype<T>(transfer_prop),
                               ~memory_dataspace,
-                              ~file_space,
+                              ~cached_dataspace(),
                               ~transfer_prop,
                               buffer);
 
         Utils::runtime_assert(err >= 0, "H5Dataset write fails.");
+        transfer_prop.check_collective(err);
     }
 
     template <class T>
     void write(const T*                         buffer,
                const H5Dataspace&               memory_dataspace,
                const H5Dataspace&               file_dataspace,
-               const H5DatasetTransferProperty& transfer_prop = H5DatasetTransferProperty()) const {
-
-        H5Datatype file_dtype = this->get_datatype();
+               const H5DatasetTransferProperty& transfer_prop =
+                   default_property<H5DatasetTransferProperty>()) const {
+        auto lock = detail::library_lock();
 
         herr_t err = H5Dwrite(this->get_handle(),
-                              ~file_dtype,
+                              this->memory_datatype<T>(transfer_prop),
                               ~memory_dataspace,
                               ~file_dataspace,
                               ~transfer_prop,
                               buffer);
 
         Utils::runtime_assert(err >= 0, "H5Dataset write fails.");
+        transfer_prop.check_collective(err);
     }
 
     template <class T>
     void read(T*                               buffer,
               const H5Dataspace&               memory_dataspace = H5DataspaceAll(),
-              const H5DatasetTransferProperty& transfer_prop    = H5DatasetTransferProperty()) {
-
-        H5Dataspace file_space = this->get_dataspace();
-        H5Datatype  file_dtype = this->get_datatype();
+              const H5DatasetTransferProperty& transfer_prop =
+                  default_property<H5DatasetTransferProperty>()) {
+        auto lock = detail::library_lock();
 
         herr_t err = H5Dread(this->get_handle(),
-                             ~file_dtype,
+                             this->memory_datatype<T>(transfer_prop),
                              ~memory_dataspace,
-                             ~file_space,
+                             ~cached_dataspace(),
                              ~transfer_prop,
                              buffer);
         Utils::runtime_assert(err >= 0, "H5Dataset read fails.");
+        transfer_prop.check_collective(err);
     }
 
     template <class T>
     void read(T*                               buffer,
               const H5Dataspace&               memory_dataspace,
               const H5Dataspace&               file_dataspace,
-              const H5DatasetTransferProperty& transfer_prop = H5DatasetTransferProperty()) {
-
-        H5Datatype file_dtype = this->get_datatype();
+              const H5DatasetTransferProperty& transfer_prop =
+                  default_property<H5DatasetTransferProperty>()) {
+        auto lock = detail::library_lock();
 
         herr_t err = H5Dread(this->get_handle(),
-                             ~file_dtype,
+                             this->memory_datatype<T>(transfer_prop),
                              ~memory_dataspace,
                              ~file_dataspace,
                              ~transfer_prop,
                              buffer);
         Utils::runtime_assert(err >= 0, "H5Dataset read fails.");
+        transfer_prop.check_collective(err);
+    }
+
+    ///
+    ///@brief Writes a contiguous container, e.g. std::vector, std::array or std::span, to the whole
+    ///       dataset. The container has to hold as many elements as the dataset.
+    ///
+    ///@param data container of the elements in row-major order
+    ///@param transfer_prop transfer property list
+    ///
+    template <class C, std::enable_if_t<detail::is_contiguous_container_v<C>, int> = 0>
+    void write(const C&                         data,
+               const H5DatasetTransferProperty& transfer_prop =
+                   default_property<H5DatasetTransferProperty>()) const {
+        Utils::runtime_assert(std::size(data) == element_count(),
+                              "H5Dataset container size does not match the dataset.");
+        write(std::data(data), H5DataspaceAll(), transfer_prop);
+    }
+
+    ///
+    ///@brief Writes a contiguous container to a selection of the dataset.
+    ///
+    ///@param data container holding as many elements as selected in the file dataspace
+    ///@param file_dataspace selection in the dataset
+    ///@param transfer_prop transfer property list
+    ///
+    template <class C, std::enable_if_t<detail::is_contiguous_container_v<C>, int> = 0>
+    void write(const C&                         data,
+               const H5Dataspace&               file_dataspace,
+               const H5DatasetTransferProperty& transfer_prop =
+                   default_property<H5DatasetTransferProperty>()) const {
+        write(H5MemoryView(std::data(data), {std::size(data)}), file_dataspace, transfer_prop);
+    }
+
+    ///
+    ///@brief Writes the elements of a memory view to a selection of the dataset.
+    ///
+    ///@param view memory holding as many elements as selected in the file dataspace
+    ///@param file_dataspace selection in the dataset, the whole dataset by default
+    ///@param transfer_prop transfer property list
+    ///
+    template <class T>
+    void write(const H5MemoryView<T>&           view,
+               const H5Dataspace&               file_dataspace = H5DataspaceAll(),
+               const H5DatasetTransferProperty& transfer_prop =
+                   default_property<H5DatasetTransferProperty>()) const {
+        write(view.data(), memory_dataspace(view), file_dataspace, transfer_prop);
+    }
+
+    ///
+    ///@brief Reads the whole dataset into a contiguous container, e.g. std::vector, std::array or
+    ///       std::span. The container has to hold as many elements as the dataset.
+    ///
+    ///@param data container receiving the elements in row-major order
+    ///@param transfer_prop transfer property list
+    ///
+    template <class C, std::enable_if_t<detail::is_contiguous_container_v<C>, int> = 0>
+    void read(C&                               data,
+              const H5DatasetTransferProperty& transfer_prop =
+                  default_property<H5DatasetTransferProperty>()) {
+        Utils::runtime_assert(std::size(data) == element_count(),
+                              "H5Dataset container size does not match the dataset.");
+        read(std::data(data), H5DataspaceAll(), transfer_prop);
+    }
+
+    ///
+    ///@brief Reads a selection of the dataset into a contiguous container.
+    ///
+    ///@param data container holding as many elements as selected in the file dataspace
+    ///@param file_dataspace selection in the dataset
+    ///@param transfer_prop transfer property list
+    ///
+    template <class C, std::enable_if_t<detail::is_contiguous_container_v<C>, int> = 0>
+    void read(C&                               data,
+              const H5Dataspace&               file_dataspace,
+              const H5DatasetTransferProperty& transfer_prop =
+                  default_property<H5DatasetTransferProperty>()) {
+        read(H5MemoryView(std::data(data), {std::size(data)}), file_dataspace, transfer_prop);
+    }
+
+    ///
+    ///@brief Reads a selection of the dataset into the elements of a memory view.
+    ///
+    ///@param view memory holding as many elements as selected in the file dataspace
+    ///@param file_dataspace selection in the dataset, the whole dataset by default
+    ///@param transfer_prop transfer property list
+    ///
+    template <class T>
+    void read(const H5MemoryView<T>&           view,
+              const H5Dataspace&               file_dataspace = H5DataspaceAll(),
+              const H5DatasetTransferProperty& transfer_prop =
+                  default_property<H5DatasetTransferProperty>()) {
+        static_assert(!std::is_const_v<T>, "H5Dataset can not read into a view of const elements.");
+        read(view.data(), memory_dataspace(view), file_dataspace, transfer_prop);
+    }
+
+    ///
+    ///@brief Reads the whole dataset into a new buffer with the dimensions of the dataset.
+    ///
+    ///@tparam T element type
+    ///@param transfer_prop transfer property list
+    ///@return H5Buffer<T> buffer aligned to 64 bytes
+    ///
+    template <class T>
+    H5Buffer<T> read_all(const H5DatasetTransferProperty& transfer_prop =
+                             default_property<H5DatasetTransferProperty>()) {
+        H5Buffer<T> ret(cached_dataspace().get_dimensions());
+        read(ret.data(), H5DataspaceAll(), transfer_prop);
+        return ret;
+    }
+
+    ///
+    ///@brief Reads the whole dataset into a buffer taken from a pool.
+    ///
+    ///@tparam T element type
+    ///@param pool pool providing the memory, the buffer returns it on destruction
+    ///@param transfer_prop transfer property list
+    ///@return H5Buffer<T> buffer aligned to 64 bytes
+    ///
+    template <class T>
+    H5Buffer<T> read_all(const H5BufferPool&              pool,
+                         const H5DatasetTransferProperty& transfer_prop =
+                             default_property<H5DatasetTransferProperty>()) {
+        H5Buffer<T> ret(cached_dataspace().get_dimensions(), pool);
+        read(ret.data(), H5DataspaceAll(), transfer_prop);
+        return ret;
+    }
+
+    ///
+    ///@brief Reads the whole dataset into a vector, which is resized to the number of elements.
+    ///       Memory already held by the vector is reused, and the allocator of the vector, e.g.
+    ///       H5AlignedAllocator, is used otherwise.
+    ///
+    ///@param data vector receiving the elements in row-major order
+    ///@param transfer_prop transfer property list
+    ///
+    template <class T, class Alloc>
+    void read_all(std::vector<T, Alloc>&           data,
+                  const H5DatasetTransferProperty& transfer_prop =
+                      default_property<H5DatasetTransferProperty>()) {
+        data.resize(element_count());
+        read(data.data(), H5DataspaceAll(), transfer_prop);
+    }
+
+    ///
+    ///@brief Reads a block of the dataset into a new buffer with the dimensions of the block.
+    ///
+    ///@tparam T element type
+    ///@param start index of the first element of the block
+    ///@param count dimensions of the block
+    ///@param transfer_prop transfer property list
+    ///@return H5Buffer<T> buffer aligned to 64 bytes
+    ///
+    template <class T>
+    H5Buffer<T> read_slab(const std::vector<size_t>&       start,
+                          const std::vector<size_t>&       count,
+                          const H5DatasetTransferProperty& transfer_prop =
+                              default_property<H5DatasetTransferProperty>()) {
+        H5Buffer<T> ret(count);
+        read(ret.view(), H5Hyperslab::select(cached_dataspace(), start, count), transfer_prop);
+        return ret;
+    }
+
+    ///
+    ///@brief Reads a block of the dataset into a buffer taken from a pool.
+    ///
+    ///@tparam T element type
+    ///@param start index of the first element of the block
+    ///@param count dimensions of the block
+    ///@param pool pool providing the memory, the buffer returns it on destruction
+    ///@param transfer_prop transfer property list
+    ///@return H5Buffer<T> buffer aligned to 64 bytes
+    ///
+    template <class T>
+    H5Buffer<T> read_slab(const std::vector<size_t>&       start,
+                          const std::vector<size_t>&       count,
+                          const H5BufferPool&              pool,
+                          const H5DatasetTransferProperty& transfer_prop =
+                              default_property<H5DatasetTransferProperty>()) {
+        H5Buffer<T> ret(count, pool);
+        read(ret.view(), H5Hyperslab::select(cached_dataspace(), start, count), transfer_prop);
+        return ret;
+    }
+
+    ///
+    ///@brief Writes some or all members of a compound dataset from separate arrays, one per
+    ///       member (structure of arrays). A single column is written straight from its array.
+    ///       Several columns are interleaved into records of just these members first, which
+    ///       HDF5 then writes without converting the other members. Members not written keep
+    ///       their values.
+    ///
+    ///@param columns member names and values, each holding as many elements as selected
+    ///@param file_dataspace selection in the dataset, the whole dataset by default
+    ///@param transfer_prop transfer property list
+    ///
+    void write_columns(const std::vector<H5Column>&     columns,
+                       const H5Dataspace&               file_dataspace = H5DataspaceAll(),
+                       const H5DatasetTransferProperty& transfer_prop =
+                           default_property<H5DatasetTransferProperty>()) const {
+        auto         lock = detail::library_lock();
+        const size_t n    = column_length(columns, file_dataspace);
+
+        detail::H5ColumnLayout     layout(columns);
+        const void*                buffer = columns[0].data();
+        std::vector<unsigned char> records;
+        if (columns.size() > 1) {
+            records.resize(n * layout.record_size);
+            layout.gather(columns, records.data(), n);
+            buffer = records.data();
+        }
+
+        herr_t err = H5Dwrite(this->get_handle(),
+                              ~layout.type,
+                              ~column_dataspace(n, file_dataspace),
+                              ~file_dataspace,
+                              ~transfer_prop,
+                              buffer);
+        Utils::runtime_assert(err >= 0, "H5Dataset write_columns fails.");
+        transfer_prop.check_collective(err);
+    }
+
+    ///
+    ///@brief Reads some members of a compound dataset into separate arrays, one per member.
+    ///       Only the requested members are converted, in a single pass over the selection.
+    ///
+    ///@param columns member names and containers sized to the number of selected elements
+    ///@param file_dataspace selection in the dataset, the whole dataset by default
+    ///@param transfer_prop transfer property list
+    ///
+    void read_columns(const std::vector<H5Column>&     columns,
+                      const H5Dataspace&               file_dataspace = H5DataspaceAll(),
+                      const H5DatasetTransferProperty& transfer_prop =
+                          default_property<H5DatasetTransferProperty>()) {
+        auto         lock = detail::library_lock();
+        const size_t n    = column_length(columns, file_dataspace);
+
+        detail::H5ColumnLayout     layout(columns);
+        void*                      buffer = columns[0].target();
+        std::vector<unsigned char> records;
+        if (columns.size() > 1) {
+            records.resize(n * layout.record_size);
+            buffer = records.data();
+        }
+
+        herr_t err = H5Dread(this->get_handle(),
+                             ~layout.type,
+                             ~column_dataspace(n, file_dataspace),
+                             ~file_dataspace,
+                             ~transfer_prop,
+                             buffer);
+        Utils::runtime_assert(err >= 0, "H5Dataset read_columns fails.");
+        transfer_prop.check_collective(err);
+
+        if (columns.size() > 1) { layout.scatter(records.data(), columns, n); }
+    }
+
+    ///
+    ///@brief Reads a single member of a compound dataset.
+    ///
+    ///@tparam T element type of the member in memory
+    ///@param name member name
+    ///@param transfer_prop transfer property list
+    ///@return std::vector<T> the values of the member for all elements of the dataset
+    ///
+    template <class T>
+    std::vector<T> read_column(const std::string&               name,
+                               const H5DatasetTransferProperty& transfer_prop =
+                                   default_property<H5DatasetTransferProperty>()) {
+        std::vector<T> ret(element_count());
+        read_columns({H5Column(name, ret)}, H5DataspaceAll(), transfer_prop);
+        return ret;
+    }
+
+    ///
+    ///@brief Returns the memory dataspace of a view, created on the first use of its shape.
+    ///
+    ///@param view memory view
+    ///@return const H5Dataspace& the cached memory dataspace
+    ///
+    template <class T> const H5Dataspace& memory_dataspace(const H5MemoryView<T>& view) const {
+        auto key = view.shape_key();
+        for (auto it = m_memory_spaces.begin(); it != m_memory_spaces.end(); ++it) {
+            if (it->first == key) { return it->second; }
+        }
+        if (m_memory_spaces.size() == max_memory_spaces) {
+            m_memory_spaces.erase(m_memory_spaces.begin());
+        }
+        m_memory_spaces.emplace_back(std::move(key), view.create_dataspace());
+        return m_memory_spaces.back().second;
+    }
+
+    ///
+    ///@brief Returns the memory datatype used when transferring a buffer of T. Checks that it is
+    ///       identical to the file datatype, or the same compound in another layout, unless the
+    ///       transfer property allows conversion.
+    ///
+    ///@param transfer_prop transfer property list of the read or write call
+    ///@return hid_t the memory datatype handle, or the file datatype if T has no
+    /// H5DatatypeCreator
+    ///
+    template <class T>
+    hid_t memory_datatype([[maybe_unused]] const H5DatasetTransferProperty& transfer_prop) const {
+
+        if constexpr (is_h5_convertible_v<T>) {
+            hid_t mem_type = detail::memory_type<T>();
+
+            // identity of the shared memory type was already verified, no conversion takes place
+            auto& cache = metadata();
+            if (mem_type == cache.matching_type) { return mem_type; }
+
+            if (H5::type_equal(mem_type, ~cache.file_type)) {
+                cache.matching_type = mem_type;
+                return mem_type;
+            }
+
+            // a packed file layout of the memory compound only moves the members
+            if (mem_type == cache.layout_type ||
+                H5DatatypeCompound::same_members(mem_type, ~cache.file_type)) {
+                cache.layout_type = mem_type;
+                return mem_type;
+            }
+
+            Utils::runtime_assert(transfer_prop.type_conversion_allowed(),
+                                  "H5Dataset memory and file datatypes differ.");
+            return mem_type;
+        } else {
+            return ~cached_datatype();
+        }
     }
 
 private:
+    // file dataspace and datatype, shared by the copies of a handle so that an extent changed
+    // through one of them is seen by all
+    struct Metadata {
+        H5Dataspace file_space;
+        H5Datatype  file_type;
+        hid_t       matching_type = H5I_INVALID_HID;
+        hid_t       layout_type   = H5I_INVALID_HID; // differs from the file type in layout only
+        bool        loaded        = false;
+
+        Metadata() = default;
+
+        explicit Metadata(const H5Dataset& dataset)
+            : file_space(dataset.get_dataspace())
+            , file_type(dataset.get_datatype())
+            , loaded(true) {}
+    };
+    std::shared_ptr<Metadata> m_metadata;
+
+    // empty for a closed or default constructed handle, loaded on first use by views
+    Metadata& metadata() const {
+        static Metadata none;
+        if (!m_metadata) { return none; }
+        // copies of the handle, e.g. one held by an H5AsyncWriter, share the metadata
+        auto lock = detail::library_lock();
+        if (!m_metadata->loaded) { *m_metadata = Metadata(*this); }
+        return *m_metadata;
+    }
+
+    // memory dataspaces of the most recently transferred shapes, oldest first
+    static constexpr size_t max_memory_spaces = 8;
+    mutable std::vector<std::pair<std::vector<size_t>, H5Dataspace>> m_memory_spaces;
+
+    size_t column_length(const std::vector<H5Column>& columns,
+                         const H5Dataspace&           file_dataspace) const {
+        Utils::runtime_assert(!columns.empty(), "H5Dataset no columns given.");
+        size_t n = element_count();
+        if (~file_dataspace != ~H5DataspaceAll()) {
+            hssize_t selected = H5Sget_select_npoints(~file_dataspace);
+            Utils::runtime_assert(selected >= 0, "H5Dataset get_select_npoints fails.");
+            n = size_t(selected);
+        }
+        for (const auto& c : columns) {
+            Utils::runtime_assert(c.size() == n, "H5Dataset column length does not match.");
+        }
+        return n;
+    }
+
+    // H5S_ALL for the whole dataset, which has the shape of the dataset instead of a 1-d shape
+    H5Dataspace column_dataspace(size_t n, const H5Dataspace& file_dataspace) const {
+        if (~file_dataspace == ~H5DataspaceAll()) { return H5DataspaceAll(); }
+        return memory_dataspace(H5MemoryView<const unsigned char>(nullptr, {n}));
+    }
+
+    size_t element_count() const {
+        auto     lock = detail::library_lock();
+        hssize_t n    = H5Sget_simple_extent_npoints(~cached_dataspace());
+        Utils::runtime_assert(n >= 0, "H5Dataset element_count fails.");
+        return size_t(n);
+    }
+
     hid_t static dataset_create(const H5Location&              loc,
                                 const std::string&             name,
                                 const H5Datatype&              type,
@@ -167,6 +766,7 @@ private:
                                 const H5LinkCreateProperty&    link_prop,
                                 const H5DatasetCreateProperty& creat_prop,
                                 const H5DatasetAccessProperty& acc_prop) {
+        auto lock = detail::library_lock();
 
         hid_t id = H5Dcreate(
             ~loc, name.c_str(), ~type, ~file_dataspace, ~link_prop, ~creat_prop, ~acc_prop);
@@ -182,10 +782,13 @@ private:
               const H5DatasetCreateProperty& creat_prop,
               const H5DatasetAccessProperty& acc_prop)
         : H5Object(
-              dataset_create(loc, name, type, file_dataspace, link_prop, creat_prop, acc_prop)) {}
+              dataset_create(loc, name, type, file_dataspace, link_prop, creat_prop, acc_prop),
+              &H5Dclose)
+        , m_metadata(std::make_shared<Metadata>(*this)) {}
 
     explicit H5Dataset(hid_t id)
-        : H5Object(id){};
+        : H5Object(id, &H5Dclose)
+        , m_metadata(std::make_shared<Metadata>(*this)) {}
 };
 
 } // namespace H5Wrapper
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <limits>
 #include <vector>
 
 #include "h5_functions.hpp"
@@ -15,20 +16,45 @@ class H5Dataspace : public H5Object {
 public:
     using dims_array = std::vector<size_t>;
 
+    ///
+    ///@brief Maximum dimension size of a dimension which can be extended without limit.
+    ///
+    static constexpr size_t unlimited = std::numeric_limits<size_t>::max();
+
     H5Dataspace() = default;
 
     // this has to be here so that dimensions can be read from file
     explicit H5Dataspace(hid_t id)
-        : H5Object(id) {
+        : H5Object(id, &H5Sclose) {
         //Utils::runtime_assert(get_type() == H5Object::Type::DATASPACE, "Not a dataspace handle.");
     }
 
+    ///
+    ///@brief Construct a non-owning view of a dataspace owned elsewhere.
+    ///
+    ///@param id dataspace identifier
+    ///
+    H5Dataspace(hid_t id, H5Object::Borrowed tag) noexcept
+        : H5Object(id, tag) {}
+
 
 
     static H5Dataspace create(const std::vector<size_t>& dims) {
         return H5Dataspace(dims.begin(), dims.end());
     }
 
+    ///
+    ///@brief Creates a simple dataspace which can be extended up to the maximum dimensions.
+    ///
+    ///@param dims Current dimensions
+    ///@param max_dims Maximum dimensions, H5Dataspace::unlimited for dimensions without a limit.
+    ///@return H5Dataspace the created dataspace
+    ///
+    static H5Dataspace create(const std::vector<size_t>& dims,
+                              const std::vector<size_t>& max_dims) {
+        return H5Dataspace(create_simple(dims, max_dims));
+    }
+
     static H5Dataspace create(std::initializer_list<size_t> dims) {
         return H5Dataspace::create(std::vector(dims));
     }
@@ -47,9 +73,17 @@ public:
 
     dims_array get_dimensions() const { return get_dimensions(this->get_handle()); }
 
+    ///
+    ///@brief Get the maximum dimensions of the dataspace.
+    ///
+    ///@return dims_array maximum dimensions, H5Dataspace::unlimited for unlimited dimensions.
+    ///
+    dims_array get_max_dimensions() const { return get_max_dimensions(this->get_handle()); }
+
     size_t get_rank() const { return get_rank(this->get_handle()); }
 
     hid_t clone_handle() const {
+        auto lock = detail::library_lock();
 
         hid_t id = H5Scopy(this->get_handle());
         Utils::runtime_assert(id >= 0, "H5Dataspace::clone_handle fails.");
@@ -76,19 +110,38 @@ private:
 
 
     template <class IT> static hid_t create_simple(const IT begin, const IT end) {
+        auto                 lock = detail::library_lock();
         std::vector<hsize_t> dims(begin, end);
         return H5Screate_simple(int(dims.size()), dims.data(), NULL);
     }
 
+    static hid_t create_simple(const std::vector<size_t>& dims,
+                               const std::vector<size_t>& max_dims) {
+        auto lock = detail::library_lock();
+        Utils::runtime_assert(dims.size() == max_dims.size(), "H5Dataspace rank mismatch.");
+
+        std::vector<hsize_t> c_dims(dims.begin(), dims.end());
+        std::vector<hsize_t> c_max_dims(max_dims.size());
+        for (size_t i = 0; i < max_dims.size(); ++i) {
+            c_max_dims[i] = (max_dims[i] == unlimited) ? H5S_UNLIMITED : hsize_t(max_dims[i]);
+        }
+
+        hid_t id = H5Screate_simple(int(c_dims.size()), c_dims.data(), c_max_dims.data());
+        Utils::runtime_assert(id >= 0, "H5Dataspace create_simple fails.");
+        return id;
+    }
+
     
 
     static size_t get_rank(hid_t id) {
-        int n_dims = H5Sget_simple_extent_ndims(id);
+        auto lock   = detail::library_lock();
+        int  n_dims = H5Sget_simple_extent_ndims(id);
         Utils::runtime_assert(n_dims >= 0, "H5Dataspace get_rank fails.");
         return size_t(n_dims);
     }
 
     static dims_array get_dimensions(hid_t id) {
+        auto                 lock = detail::library_lock();
         std::vector<hsize_t> dims(get_rank(id));
         std::vector<hsize_t> max_dims(get_rank(id));
         auto                 err = H5Sget_simple_extent_dims(id, dims.data(), max_dims.data());
@@ -96,6 +149,19 @@ private:
         dims_array ret(dims.begin(), dims.end());
         return ret;
     }
+
+    static dims_array get_max_dimensions(hid_t id) {
+        auto                 lock = detail::library_lock();
+        std::vector<hsize_t> dims(get_rank(id));
+        std::vector<hsize_t> max_dims(get_rank(id));
+        auto                 err = H5Sget_simple_extent_dims(id, dims.data(), max_dims.data());
+        Utils::runtime_assert(err >= 0, "H5Dataspace get_max_dimensions fails.");
+        dims_array ret(max_dims.size());
+        for (size_t i = 0; i < max_dims.size(); ++i) {
+            ret[i] = (max_dims[i] == H5S_UNLIMITED) ? unlimited : size_t(max_dims[i]);
+        }
+        return ret;
+    }
 };
 
 } // namespace H5Wrapper
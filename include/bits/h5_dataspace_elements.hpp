@@ -38,7 +38,8 @@ private:
 
     static hid_t select_elements(const H5Dataspace& parent, size_t count, dims_array indices)
     {
-        hid_t id = parent.clone_handle();
+        auto  lock = detail::library_lock();
+        hid_t id   = parent.clone_handle();
 
 
         if (count == 0 && indices.size() == 0){
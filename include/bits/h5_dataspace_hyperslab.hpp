@@ -41,6 +41,7 @@ public:
     ///@return std::vector<size_t> start indices
     ///
     std::vector<size_t> start() const {
+        auto                 lock = detail::library_lock();
         std::vector<hsize_t> start(this->get_rank());
         std::vector<hsize_t> end(this->get_rank());
         auto err = H5Sget_select_bounds(this->get_handle(), start.data(), end.data());
@@ -54,6 +55,7 @@ public:
     ///@return std::vector<size_t> end indices
     ///
     std::vector<size_t> end() const {
+        auto                 lock = detail::library_lock();
         std::vector<hsize_t> start(this->get_rank());
         std::vector<hsize_t> end(this->get_rank());
         auto err = H5Sget_select_bounds(this->get_handle(), start.data(), end.data());
@@ -104,6 +106,7 @@ private:
                                   const dims_array&  extent,
                                   const dims_array&  stride,
                                   const dims_array&  block) {
+        auto lock = detail::library_lock();
 
         Utils::runtime_assert(valid_hyperslab(parent, start, extent, stride, block),
                               "Invalid hyperslab dimensions.");
@@ -9,10 +9,16 @@ class H5DataspaceScalar : public H5Dataspace {
 
 public:
     
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wold-style-cast"
-    H5DataspaceScalar() : H5Dataspace(H5S_SCALAR) {}
-    #pragma GCC diagnostic pop
+    // H5S_SCALAR is a dataspace class, not an identifier, the dataspace has to be created
+    H5DataspaceScalar() : H5Dataspace(create_scalar()) {}
+
+private:
+    static hid_t create_scalar() {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Screate(H5S_SCALAR);
+        Utils::runtime_assert(id >= 0, "H5DataspaceScalar create fails.");
+        return id;
+    }
     
 
 };
@@ -37,7 +37,15 @@ public:
 
     // TODO: make this protected and have some static factory method
     explicit H5Datatype(hid_t id)
-        : H5Object(id) {}
+        : H5Object(id, &H5Tclose) {}
+
+    ///
+    ///@brief Construct a non-owning view of a datatype owned elsewhere.
+    ///
+    ///@param id datatype identifier
+    ///
+    H5Datatype(hid_t id, H5Object::Borrowed tag) noexcept
+        : H5Object(id, tag) {}
 
     ///
     ///@brief Opens a committed (named) datatype.
@@ -49,7 +57,9 @@ public:
     ///
     static H5Datatype open(const H5Location&               loc,
                            const std::string&              datatype_name,
-                           const H5DatatypeAccessProperty& ac = H5DatatypeAccessProperty()) {
+                           const H5DatatypeAccessProperty& ac =
+                               default_property<H5DatatypeAccessProperty>()) {
+        auto lock = detail::library_lock();
         // TODO: create a factory method to return a correct type
         hid_t id = H5Topen(~loc, datatype_name.c_str(), ~ac);
         Utils::runtime_assert(id >= 0, "Datype open fails.");
@@ -64,7 +74,8 @@ public:
     ///@return H5Datatype a datatype identifier if successful.
     ///
     static H5Datatype copy(hid_t other) {
-        hid_t id = H5Tcopy(other);
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Tcopy(other);
         Utils::runtime_assert(id >= 0, "Dataype copy fails.");
         return H5Datatype(id);
     }
@@ -101,10 +112,11 @@ public:
     ///
     void commit(const H5Location&               loc,
                 const std::string&              datatype_name,
-                const H5LinkCreateProperty&     lc = H5LinkCreateProperty(),
-                const H5DatatypeCreateProperty& dc = H5DatatypeCreateProperty(),
-                const H5DatatypeAccessProperty& da = H5DatatypeAccessProperty()) {
-        herr_t err = H5Tcommit(~loc, datatype_name.c_str(), this->get_handle(), ~lc, ~dc, ~da);
+                const H5LinkCreateProperty&     lc = default_property<H5LinkCreateProperty>(),
+                const H5DatatypeCreateProperty& dc = default_property<H5DatatypeCreateProperty>(),
+                const H5DatatypeAccessProperty& da = default_property<H5DatatypeAccessProperty>()) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Tcommit(~loc, datatype_name.c_str(), this->get_handle(), ~lc, ~dc, ~da);
         Utils::runtime_assert(err >= 0, "Datatype commit fails.");
     }
 
@@ -115,6 +127,7 @@ public:
     ///@return false if the datatype has not been committed.
     ///
     bool commited() const {
+        auto   lock  = detail::library_lock();
         htri_t query = H5Tcommitted(this->get_handle());
         Utils::runtime_assert(query >= 0, "Datatype commited fails.");
         if (query > 0) { return true; }
@@ -127,7 +140,7 @@ public:
     ///@return H5T_class_t  H5T_INTEGER, H5T_FLOAT, H5T_STRING, H5T_BITFIELD, H5T_OPAQUE,
     /// H5T_COMPOUND, H5T_REFERENCE, H5T_ENUM, H5T_VLEN, H5T_ARRAY or otherwise H5T_NO_CLASS
     ///
-    H5T_class_t get_class() const { return H5Tget_class(this->get_handle()); }
+    H5T_class_t get_class() const { return get_class(this->get_handle()); }
 
     ///
     ///@brief Returns the datatype class identifier.
@@ -136,7 +149,10 @@ public:
     ///@return H5T_class_t  H5T_INTEGER, H5T_FLOAT, H5T_STRING, H5T_BITFIELD, H5T_OPAQUE,
     /// H5T_COMPOUND, H5T_REFERENCE, H5T_ENUM, H5T_VLEN, H5T_ARRAY or otherwise H5T_NO_CLASS
     ///
-    static H5T_class_t get_class(hid_t id) { return H5Tget_class(id); }
+    static H5T_class_t get_class(hid_t id) {
+        auto lock = detail::library_lock();
+        return H5Tget_class(id);
+    }
 
     ///
     ///@brief sets the total size in bytes, size, for a datatype.
@@ -144,7 +160,8 @@ public:
     ///@param size New datatype size in bytes
     ///
     void set_size(size_t size) {
-        herr_t err = H5Tset_size(this->get_handle(), size);
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Tset_size(this->get_handle(), size);
         Utils::runtime_assert(err >= 0, "Datatype set size fails.");
     }
 
@@ -153,7 +170,10 @@ public:
     ///
     ///@return size_t size of a datatype in bytes.
     ///
-    size_t get_size() const { return H5Tget_size(this->get_handle()); }
+    size_t get_size() const {
+        auto lock = detail::library_lock();
+        return H5Tget_size(this->get_handle());
+    }
 
     ///
     ///@brief Returns the native datatype of a specified datatype.
@@ -164,7 +184,8 @@ public:
     /// if successful
     ///
     H5Datatype get_native_type(H5T_direction_t direction) const {
-        hid_t id = H5Tget_native_type(this->get_handle(), direction);
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Tget_native_type(this->get_handle(), direction);
         Utils::runtime_assert(id >= 0, "Datatype get native type fails.");
         return H5Datatype(id);
     }
@@ -177,6 +198,7 @@ public:
     ///@return false if does not contain any datatype of a type class
     ///
     bool detect_class(H5T_class_t type_class) const {
+        auto   lock  = detail::library_lock();
         htri_t query = H5Tdetect_class(this->get_handle(), type_class);
         Utils::runtime_assert(query >= 0, "Datatype detect class fails.");
         if (query > 0) { return true; }
@@ -188,7 +210,10 @@ public:
     ///
     ///@return size_t Returns the number of significant bits if successful; otherwise 0.
     ///
-    size_t get_precision() const { return H5Tget_precision(this->get_handle()); }
+    size_t get_precision() const {
+        auto lock = detail::library_lock();
+        return H5Tget_precision(this->get_handle());
+    }
 
     ///
     ///@brief Sets the precision of an atomic datatype.
@@ -196,7 +221,8 @@ public:
     ///@param precision Number of bits of precision for datatype.
     ///
     void set_precision(size_t precision) const {
-        herr_t err = H5Tset_precision(this->get_handle(), precision);
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Tset_precision(this->get_handle(), precision);
         Utils::runtime_assert(err >= 0, "Datatype set precision fails.");
     }
 
@@ -206,7 +232,8 @@ public:
     ///@return size_t Returns an offset value if successful.
     ///
     size_t get_offset() const {
-        int offset = H5Tget_offset(this->get_handle());
+        auto lock   = detail::library_lock();
+        int  offset = H5Tget_offset(this->get_handle());
         Utils::runtime_assert(offset >= 0, "Datatype get offset fails.");
         return size_t(offset);
     }
@@ -217,7 +244,8 @@ public:
     ///@param offset Offset of first significant bit.
     ///
     void set_offset(size_t offset) {
-        herr_t err = H5Tset_offset(this->get_handle(), offset);
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Tset_offset(this->get_handle(), offset);
         Utils::runtime_assert(err >= 0, "Datatype set offset fails.");
     }
 
@@ -231,6 +259,7 @@ public:
     ///@return std::string containing the returned filename
     ///
     std::string belongs_to_file() const{
+        auto lock = detail::library_lock();
 
         size_t some_temp_size = 1; // this should be arbitrary...
         auto   size           = H5Fget_name(this->get_handle(), NULL, some_temp_size);
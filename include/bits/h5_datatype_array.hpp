@@ -32,7 +32,8 @@ public:
     ///@return size_t rank
     ///
     size_t get_ndims() const {
-        int ndims = H5Tget_array_ndims(this->get_handle());
+        auto lock  = detail::library_lock();
+        int  ndims = H5Tget_array_ndims(this->get_handle());
         Utils::runtime_assert(ndims >= 0, "H5DatatypeArray get ndims fails.");
         return size_t(ndims);
     }
@@ -43,6 +44,7 @@ public:
     ///@return std::vector<size_t> Sizes of array dimensions.
     ///
     std::vector<size_t> get_dims() const {
+        auto                 lock = detail::library_lock();
         std::vector<hsize_t> i_dims(this->get_ndims());
         int                  err = H5Tget_array_dims(this->get_handle(), i_dims.data());
         Utils::runtime_assert(err >= 0, "H5DatatypeArray get dims fails.");
@@ -52,6 +54,7 @@ public:
 private:
     static hid_t
     array_create(const H5Datatype& basetype, size_t rank, const std::vector<size_t>& dims) {
+        auto                 lock = detail::library_lock();
         std::vector<hsize_t> dims_c(dims.begin(), dims.end());
         hid_t                id = H5Tarray_create(~basetype, static_cast<uint>(rank), dims_c.data());
         Utils::runtime_assert(id >= 0, "H5DatatypeArray array create fails.");
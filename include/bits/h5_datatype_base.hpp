@@ -8,7 +8,7 @@ template <class T> class H5DatatypeBase : public H5Object {
 
 public:
 
-    H5DatatypeBase() : H5Object( static_cast<T*>(this)->create_handle() ) {}
+    H5DatatypeBase() : H5Object( static_cast<T*>(this)->create_handle(), &H5Tclose ) {}
 
 
 };
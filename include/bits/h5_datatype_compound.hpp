@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstring> //std::strcmp
 #include <hdf5.h>
 #include <string>
 
 #include "h5_datatype.hpp"
+#include "h5_functions.hpp"
 
 #include "runtime_assert.hpp"
 
@@ -15,6 +17,64 @@ public:
 
     H5DatatypeCompound() = default;
 
+    ///
+    ///@brief Creates an empty compound datatype.
+    ///
+    ///@param size Size of the compound in bytes, sizeof the struct it describes.
+    ///@return H5DatatypeCompound the compound datatype
+    ///
+    static H5DatatypeCompound create(size_t size) {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Tcreate(H5T_COMPOUND, size);
+        Utils::runtime_assert(id >= 0, "H5DatatypeCompound create fails.");
+        return H5DatatypeCompound(id);
+    }
+
+    ///
+    ///@brief Returns a packed copy of this compound, for storing it in a file without padding.
+    ///
+    ///@return H5DatatypeCompound the packed copy
+    ///
+    H5DatatypeCompound packed() const {
+        H5DatatypeCompound ret(H5::type_copy(this->get_handle()));
+        ret.pack();
+        return ret;
+    }
+
+    ///
+    ///@brief Checks if two compound datatypes have the same members, i.e. equal names and member
+    ///       types in the same order, and differ at most in the member offsets and total size, as
+    ///       a packed file type and its native memory type do. Converting between them is a
+    ///       member-wise copy.
+    ///
+    ///@param type1 first datatype
+    ///@param type2 second datatype
+    ///@return true if both are compounds with the same members
+    ///
+    static bool same_members(hid_t type1, hid_t type2) {
+        auto lock = detail::library_lock();
+        if (H5Tget_class(type1) != H5T_COMPOUND || H5Tget_class(type2) != H5T_COMPOUND) {
+            return false;
+        }
+        int n = H5Tget_nmembers(type1);
+        if (n < 0 || n != H5Tget_nmembers(type2)) { return false; }
+        for (unsigned i = 0; i < unsigned(n); ++i) {
+            char* name1 = H5Tget_member_name(type1, i);
+            char* name2 = H5Tget_member_name(type2, i);
+            bool  same  = name1 && name2 && std::strcmp(name1, name2) == 0;
+            H5free_memory(name1);
+            H5free_memory(name2);
+            if (!same) { return false; }
+
+            H5Datatype member1(H5Tget_member_type(type1, i));
+            H5Datatype member2(H5Tget_member_type(type2, i));
+            if (!H5::type_equal(~member1, ~member2) && !same_members(~member1, ~member2)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
 
     ///
     ///@brief Retrieves the number of elements in a compound.
@@ -22,7 +82,8 @@ public:
     ///@return size_t Returns the number of elements if successful.
     ///
     size_t get_nmembers() const{
-        int nmembers = H5Tget_nmembers(this->get_handle());
+        auto lock     = detail::library_lock();
+        int  nmembers = H5Tget_nmembers(this->get_handle());
         Utils::runtime_assert(nmembers >= 0, "H5DatatypeCompound get nmembers fails.");
         return size_t(nmembers);
     }
@@ -35,6 +96,7 @@ public:
     ///@return H5T_class_t Returns the datatype class if successful.
     ///
     H5T_class_t get_member_class(size_t member_no) const{
+        auto lock    = detail::library_lock();
         auto class_t = H5Tget_member_class(this->get_handle(), unsigned(member_no));
         Utils::runtime_assert(class_t >= 0, "H5DatatypeCompound get member class fails.");
         return class_t;
@@ -47,9 +109,12 @@ public:
     ///@return std::string the member name if succesful.
     ///
     std::string get_member_name(size_t field_idx) const{
-        const char* name = H5Tget_member_name(this->get_handle(), unsigned(field_idx));
+        auto  lock = detail::library_lock();
+        char* name = H5Tget_member_name(this->get_handle(), unsigned(field_idx));
         Utils::runtime_assert(name != nullptr, "H5DatatypeCompound get member name fails.");
-        return std::string(name);
+        std::string ret(name);
+        H5free_memory(name);
+        return ret;
     }
 
     ///
@@ -59,7 +124,8 @@ public:
     ///@return size_t Returns a valid field or member index if successful.
     ///
     size_t get_member_index(const std::string& member_name) const{
-        int idx = H5Tget_member_index(this->get_handle(), member_name.c_str());
+        auto lock = detail::library_lock();
+        int  idx  = H5Tget_member_index(this->get_handle(), member_name.c_str());
         Utils::runtime_assert(idx >= 0, "H5DatatypeCompound get member index fails.");
         return size_t(idx);
     }
@@ -71,6 +137,7 @@ public:
     ///@return size_t Returns the byte offset of the field if successful.
     ///
     size_t get_member_offset(size_t member_no) const{
+        auto lock = detail::library_lock();
         return H5Tget_member_offset(this->get_handle(), unsigned(member_no));
     }
 
@@ -81,6 +148,7 @@ public:
     ///@return H5Datatype Returns the identifier of a copy of the datatype of the field if successful.
     ///
     H5Datatype get_member_type(size_t field_idx) const{
+        auto lock = detail::library_lock();
         //TODO: ensure it makes sense to return a H5Datatype, or should a factory method be used.
         hid_t id = H5Tget_member_type(this->get_handle(), unsigned(field_idx));
         Utils::runtime_assert(id >= 0, "H5DatatypeCompound get member type fails.");
@@ -96,7 +164,8 @@ public:
     ///@param offset Offset in memory structure of the field to insert.
     ///
     void insert(const H5Datatype& type, const std::string& name, size_t offset ){
-        herr_t err = H5Tinsert(this->get_handle(), name.c_str(), offset, ~type);
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Tinsert(this->get_handle(), name.c_str(), offset, ~type);
         Utils::runtime_assert(err >= 0, "H5DatatypeCompound insert fails.");
     }
     
@@ -105,10 +174,14 @@ public:
     ///
     ///
     void pack(){
-        herr_t err = H5Tpack(this->get_handle());
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Tpack(this->get_handle());
         Utils::runtime_assert(err >= 0, "H5DatatypeCompound pack fails.");
     }
 
+private:
+    explicit H5DatatypeCompound(hid_t id)
+        : H5Datatype(id) {}
 
 
 };
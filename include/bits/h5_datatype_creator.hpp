@@ -1,6 +1,7 @@
 #pragma once
 
 #include "h5_datatype.hpp"
+#include "h5_functions.hpp"
 #include <string>
 
 namespace H5Wrapper {
@@ -94,4 +95,24 @@ template <> struct H5DatatypeCreator<std::string> {
 };
 
 
+namespace detail {
+
+///
+///@brief Returns the memory datatype of T created by H5DatatypeCreator<T>. The type is created
+///       and locked on first use and shared by all subsequent calls. Locked types can not be
+///       closed, HDF5 releases them when the library shuts down.
+///
+///@return hid_t handle of the shared memory datatype
+///
+template <class T> hid_t memory_type() {
+    static const hid_t id = []() {
+        hid_t copy = H5::type_copy(~H5DatatypeCreator<T>::create());
+        H5::type_lock(copy);
+        return copy;
+    }();
+    return id;
+}
+
+} // namespace detail
+
 } // namespace H5Wrapper
\ No newline at end of file
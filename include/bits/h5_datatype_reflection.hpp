@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <cstddef> //offsetof
+#include <type_traits>
+#include <vector>
+
+#include "h5_datatype.hpp"
+#include "h5_datatype_array.hpp"
+#include "h5_datatype_compound.hpp"
+#include "h5_datatype_creator.hpp"
+
+namespace H5Wrapper {
+
+namespace detail {
+
+template <class T> struct array_extents {
+    using base_type                 = T;
+    static constexpr bool is_array = false;
+    static void           append(std::vector<size_t>&) {}
+};
+
+template <class T, size_t N> struct array_extents<T[N]> {
+    using base_type                 = typename array_extents<T>::base_type;
+    static constexpr bool is_array = true;
+    static void           append(std::vector<size_t>& dims) {
+        dims.push_back(N);
+        array_extents<T>::append(dims);
+    }
+};
+
+template <class T, size_t N> struct array_extents<std::array<T, N>> : array_extents<T[N]> {
+    static_assert(sizeof(std::array<T, N>) == N * sizeof(T), "std::array with padding.");
+};
+
+///
+///@brief Returns the datatype of a struct member. Built-in arrays and std::array, also nested
+///       ones, map to an H5DatatypeArray of their element type, everything else to the type given
+///       by H5DatatypeCreator, which may itself be a compound declared with H5WRAPPER_COMPOUND.
+///
+///@tparam M member type
+///@return H5Datatype the member datatype
+///
+template <class M> H5Datatype member_type() {
+    using extents = array_extents<M>;
+    if constexpr (extents::is_array) {
+        std::vector<size_t> dims;
+        extents::append(dims);
+        return H5DatatypeArray(
+            H5DatatypeCreator<typename extents::base_type>::create(), dims.size(), dims);
+    } else {
+        return H5DatatypeCreator<M>::create();
+    }
+}
+
+} // namespace detail
+
+} // namespace H5Wrapper
+
+// Preprocessor iteration over up to 32 members.
+#define H5WRAPPER_EXPAND(x) x
+#define H5WRAPPER_FE_1(M, T, a) M(T, a)
+#define H5WRAPPER_FE_2(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_1(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_3(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_2(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_4(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_3(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_5(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_4(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_6(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_5(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_7(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_6(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_8(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_7(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_9(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_8(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_10(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_9(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_11(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_10(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_12(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_11(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_13(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_12(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_14(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_13(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_15(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_14(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_16(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_15(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_17(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_16(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_18(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_17(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_19(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_18(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_20(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_19(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_21(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_20(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_22(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_21(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_23(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_22(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_24(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_23(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_25(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_24(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_26(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_25(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_27(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_26(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_28(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_27(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_29(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_28(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_30(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_29(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_31(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_30(M, T, __VA_ARGS__))
+#define H5WRAPPER_FE_32(M, T, a, ...) M(T, a) H5WRAPPER_EXPAND(H5WRAPPER_FE_31(M, T, __VA_ARGS__))
+#define H5WRAPPER_GET_FE( \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, \
+    _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+#define H5WRAPPER_FOR_EACH(M, T, ...) \
+    H5WRAPPER_EXPAND(H5WRAPPER_GET_FE(__VA_ARGS__, H5WRAPPER_FE_32, H5WRAPPER_FE_31, \
+    H5WRAPPER_FE_30, H5WRAPPER_FE_29, H5WRAPPER_FE_28, H5WRAPPER_FE_27, H5WRAPPER_FE_26, \
+    H5WRAPPER_FE_25, H5WRAPPER_FE_24, H5WRAPPER_FE_23, H5WRAPPER_FE_22, H5WRAPPER_FE_21, \
+    H5WRAPPER_FE_20, H5WRAPPER_FE_19, H5WRAPPER_FE_18, H5WRAPPER_FE_17, H5WRAPPER_FE_16, \
+    H5WRAPPER_FE_15, H5WRAPPER_FE_14, H5WRAPPER_FE_13, H5WRAPPER_FE_12, H5WRAPPER_FE_11, \
+    H5WRAPPER_FE_10, H5WRAPPER_FE_9, H5WRAPPER_FE_8, H5WRAPPER_FE_7, H5WRAPPER_FE_6, \
+    H5WRAPPER_FE_5, H5WRAPPER_FE_4, H5WRAPPER_FE_3, H5WRAPPER_FE_2, H5WRAPPER_FE_1)( \
+        M, T, __VA_ARGS__))
+
+#define H5WRAPPER_COMPOUND_MEMBER(Type, member)                                                    \
+    ret.insert(H5Wrapper::detail::member_type<decltype(Type::member)>(),                           \
+               #member,                                                                            \
+               offsetof(Type, member));
+
+///
+///@brief Declares a struct as a compound datatype by specializing H5DatatypeCreator for it, e.g.
+///
+///       struct Particle { double pos[3]; float mass; int id; };
+///       H5WRAPPER_COMPOUND(Particle, pos, mass, id)
+///
+///       The members are inserted with their names and the offsets of the struct, so the compound
+///       matches the struct in memory and buffers of it are transferred without any copy.
+///       create_packed() returns the same members without padding, for the type in the file; the
+///       dataset converts between the two layouts member-wise. Has to be used at global namespace
+///       scope with the fully qualified struct name. Members may be arithmetic types, arrays of
+///       them and structs declared with H5WRAPPER_COMPOUND. The memory datatype is created once
+///       per process and shared, see detail::memory_type.
+///
+#define H5WRAPPER_COMPOUND(Type, ...)                                                              \
+    template <> struct H5Wrapper::H5DatatypeCreator<Type> {                                        \
+        static_assert(std::is_standard_layout_v<Type>,                                             \
+                      "H5WRAPPER_COMPOUND requires a standard layout type.");                      \
+                                                                                                   \
+        static H5Wrapper::H5DatatypeCompound create() {                                            \
+            auto ret = H5Wrapper::H5DatatypeCompound::create(sizeof(Type));                        \
+            H5WRAPPER_FOR_EACH(H5WRAPPER_COMPOUND_MEMBER, Type, __VA_ARGS__)                       \
+            return ret;                                                                            \
+        }                                                                                          \
+                                                                                                   \
+        static H5Wrapper::H5DatatypeCompound create_packed() { return create().packed(); }         \
+    };
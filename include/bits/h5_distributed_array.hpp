@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm> //std::equal, std::sort, std::unique, std::remove_if
+#include <array>
+#include <mpi.h>
+#include <stdexcept> //std::runtime_error
+#include <string>
+#include <vector>
+
+#include "h5_dataset.hpp"
+#include "h5_dataspace.hpp"
+#include "h5_dataspace_hyperslab.hpp"
+#include "h5_datatype_creator.hpp"
+#include "h5_location.hpp"
+#include "h5_property.hpp"
+#include "is_parallel.hpp"
+
+namespace H5Wrapper {
+
+///
+///@brief An N dimensional array decomposed into one block per rank, e.g. the domain of a
+///       structured grid code. Every rank holds the interior of its block surrounded by ghost
+///       layers in a contiguous, row major buffer, and reads and writes whole fields of the
+///       global array with a single collective call. The file and memory selections are
+///       computed once on construction, where the blocks of all ranks are exchanged to check
+///       that they lie within the global array and cover it without overlapping.
+///
+///@tparam T element type, has to be convertible with H5DatatypeCreator
+///@tparam N number of dimensions
+///
+template <class T, size_t N> class H5DistributedArray {
+
+public:
+    using index_array = std::array<size_t, N>;
+
+    H5DistributedArray() = default;
+
+    ///
+    ///@brief Constructs the decomposition. Collective over the communicator, which has to hold
+    ///       the ranks taking part in the reads and writes, i.e. the ranks of the file.
+    ///
+    ///@param global_dims dimensions of the global array
+    ///@param offset index of the first interior element of this rank in the global array
+    ///@param extent dimensions of the interior of this rank, zero in any dimension for none
+    ///@param ghost number of ghost layers on either side of the interior in every dimension
+    ///@param comm communicator of the ranks sharing the array
+    ///
+    H5DistributedArray(const index_array& global_dims,
+                       const index_array& offset,
+                       const index_array& extent,
+                       const index_array& ghost = index_array{},
+                       MPI_Comm           comm  = MPI_COMM_WORLD)
+        : m_global_dims(global_dims)
+        , m_offset(offset)
+        , m_extent(extent)
+        , m_ghost(ghost) {
+
+        // before selecting, so that an invalid block fails on every rank alike
+        validate(comm);
+
+        m_file_space  = H5Dataspace::create(m_global_dims);
+        m_file_slab   = H5Hyperslab::select(m_file_space, m_offset, m_extent);
+        m_memory_slab = H5Hyperslab::select(H5Dataspace::create(local_dims()), m_ghost, m_extent);
+    }
+
+    const index_array& global_dims() const { return m_global_dims; }
+    const index_array& offset() const { return m_offset; }
+    const index_array& extent() const { return m_extent; }
+    const index_array& ghost() const { return m_ghost; }
+
+    ///
+    ///@brief Returns the dimensions of the local buffer, the interior plus the ghost layers.
+    ///
+    ///@return index_array local dimensions
+    ///
+    index_array local_dims() const {
+        index_array ret;
+        for (size_t i = 0; i < N; ++i) { ret[i] = m_extent[i] + 2 * m_ghost[i]; }
+        return ret;
+    }
+
+    ///
+    ///@brief Returns the number of elements of the local buffer.
+    ///
+    ///@return size_t number of elements
+    ///
+    size_t local_size() const {
+        size_t ret = 1;
+        for (auto d : local_dims()) { ret *= d; }
+        return ret;
+    }
+
+    ///
+    ///@brief Creates a dataset of the global dimensions. Collective.
+    ///
+    ///@param loc Location identifier
+    ///@param name Dataset name
+    ///@param creat_prop Dataset creation property list, e.g. with chunks matching the blocks
+    ///@return H5Dataset the dataset
+    ///
+    H5Dataset create_dataset(const H5Location&              loc,
+                             const std::string&             name,
+                             const H5DatasetCreateProperty& creat_prop =
+                                 default_property<H5DatasetCreateProperty>()) const {
+        return H5Dataset::create(loc,
+                                 name,
+                                 H5DatatypeCreator<T>::create(),
+                                 m_file_space,
+                                 default_property<H5LinkCreateProperty>(),
+                                 creat_prop);
+    }
+
+    ///
+    ///@brief Writes the interior of the local buffer of every rank to its block of a dataset of
+    ///       the global dimensions. Collective.
+    ///
+    ///@param dataset the dataset
+    ///@param field local buffer of local_size() elements
+    ///@param transfer_prop transfer property list
+    ///
+    void write(const H5Dataset&                 dataset,
+               const T*                         field,
+               const H5DatasetTransferProperty& transfer_prop =
+                   H5DatasetTransferProperty::collective_default()) const {
+        check_dataset(dataset);
+        dataset.write(field, m_memory_slab, m_file_slab, transfer_prop);
+    }
+
+    ///
+    ///@brief Creates a dataset of the global dimensions and writes a field to it. Collective.
+    ///
+    ///@param loc Location identifier
+    ///@param name Dataset name
+    ///@param field local buffer of local_size() elements
+    ///@param transfer_prop transfer property list
+    ///@return H5Dataset the dataset
+    ///
+    H5Dataset write(const H5Location&                loc,
+                    const std::string&               name,
+                    const std::vector<T>&            field,
+                    const H5DatasetTransferProperty& transfer_prop =
+                        H5DatasetTransferProperty::collective_default()) const {
+        require(field.size() == local_size(),
+                "H5DistributedArray field size does not match the local block.");
+        auto dataset = create_dataset(loc, name);
+        write(dataset, field.data(), transfer_prop);
+        return dataset;
+    }
+
+    ///
+    ///@brief Reads the block of every rank from a dataset of the global dimensions into the
+    ///       interior of its local buffer. The ghost layers are left untouched. Collective.
+    ///
+    ///@param dataset the dataset
+    ///@param field local buffer of local_size() elements
+    ///@param transfer_prop transfer property list
+    ///
+    void read(H5Dataset&                       dataset,
+              T*                               field,
+              const H5DatasetTransferProperty& transfer_prop =
+                  H5DatasetTransferProperty::collective_default()) const {
+        check_dataset(dataset);
+        dataset.read(field, m_memory_slab, m_file_slab, transfer_prop);
+    }
+
+    ///
+    ///@brief Opens a dataset of the global dimensions and reads a field from it. Collective.
+    ///
+    ///@param loc Location identifier
+    ///@param name Dataset name
+    ///@param field local buffer of local_size() elements
+    ///@param transfer_prop transfer property list
+    ///
+    void read(const H5Location&                loc,
+              const std::string&               name,
+              std::vector<T>&                  field,
+              const H5DatasetTransferProperty& transfer_prop =
+                  H5DatasetTransferProperty::collective_default()) const {
+        require(field.size() == local_size(),
+                "H5DistributedArray field size does not match the local block.");
+        auto dataset = H5Dataset::open(loc, name);
+        read(dataset, field.data(), transfer_prop);
+    }
+
+private:
+    index_array m_global_dims{};
+    index_array m_offset{};
+    index_array m_extent{};
+    index_array m_ghost{};
+    H5Dataspace m_file_space;
+    H5Hyperslab m_file_slab;
+    H5Hyperslab m_memory_slab;
+
+    static void require(bool condition, const char* msg) {
+        if (!condition) { throw std::runtime_error(msg); }
+    }
+
+    void check_dataset(const H5Dataset& dataset) const {
+        const auto dims = dataset.cached_dataspace().get_dimensions();
+        require(dims.size() == N && std::equal(dims.begin(), dims.end(), m_global_dims.begin()),
+                "H5DistributedArray dataset dimensions do not match.");
+    }
+
+    ///
+    ///@brief Gathers the blocks and global dimensions of all ranks and checks that the global
+    ///       dimensions agree and that the blocks lie within the global array, do not overlap and
+    ///       add up to it, i.e. cover it exactly. Overlaps are found by sorting the blocks along
+    ///       the dimension with the most distinct offsets and sweeping over them, so only blocks
+    ///       whose ranges intersect in that dimension are compared.
+    ///
+    ///       Unlike the other checks of the wrapper, a failed check throws std::runtime_error
+    ///       also in builds without DEBUG, as an invalid decomposition silently corrupts the data.
+    ///
+    ///@param comm communicator of the ranks sharing the array
+    ///
+    void validate(MPI_Comm comm) const {
+        // offset, extent and global dimensions of every rank
+        constexpr size_t                record = 3 * N;
+        std::vector<unsigned long long> blocks(record);
+        for (size_t i = 0; i < N; ++i) {
+            blocks[i]         = m_offset[i];
+            blocks[N + i]     = m_extent[i];
+            blocks[2 * N + i] = m_global_dims[i];
+        }
+        if (is_parallel()) {
+            int size;
+            MPI_Comm_size(comm, &size);
+            std::vector<unsigned long long> mine(blocks);
+            blocks.resize(record * size_t(size));
+            int err = MPI_Allgather(mine.data(),
+                                    int(record),
+                                    MPI_UNSIGNED_LONG_LONG,
+                                    blocks.data(),
+                                    int(record),
+                                    MPI_UNSIGNED_LONG_LONG,
+                                    comm);
+            require(err == MPI_SUCCESS, "H5DistributedArray exchange fails.");
+        }
+
+        const size_t n_blocks = blocks.size() / record;
+        auto         start    = [&](size_t b, size_t i) { return blocks[record * b + i]; };
+        auto         count    = [&](size_t b, size_t i) { return blocks[record * b + N + i]; };
+        auto         global   = [&](size_t b, size_t i) { return blocks[record * b + 2 * N + i]; };
+
+        unsigned long long total = 1, covered = 0;
+        for (size_t i = 0; i < N; ++i) { total *= m_global_dims[i]; }
+
+        std::vector<size_t> non_empty;
+        for (size_t b = 0; b < n_blocks; ++b) {
+            unsigned long long volume = 1;
+            for (size_t i = 0; i < N; ++i) {
+                require(global(b, i) == m_global_dims[i],
+                        "H5DistributedArray global dimensions differ between ranks.");
+                require(start(b, i) + count(b, i) <= m_global_dims[i],
+                        "H5DistributedArray block exceeds the global array.");
+                volume *= count(b, i);
+            }
+            covered += volume;
+            if (volume != 0) { non_empty.push_back(b); }
+        }
+
+        // the dimension the blocks are spread over the most separates them best
+        size_t sweep = 0, most_starts = 0;
+        for (size_t i = 0; i < N; ++i) {
+            std::vector<unsigned long long> starts;
+            for (auto b : non_empty) { starts.push_back(start(b, i)); }
+            std::sort(starts.begin(), starts.end());
+            const size_t n_starts =
+                size_t(std::unique(starts.begin(), starts.end()) - starts.begin());
+            if (n_starts > most_starts) {
+                sweep       = i;
+                most_starts = n_starts;
+            }
+        }
+
+        std::sort(non_empty.begin(), non_empty.end(), [&](size_t a, size_t b) {
+            return start(a, sweep) < start(b, sweep);
+        });
+        std::vector<size_t> active; // blocks still intersecting the sweep position
+        for (auto b : non_empty) {
+            active.erase(std::remove_if(active.begin(),
+                                        active.end(),
+                                        [&](size_t o) {
+                                            return start(o, sweep) + count(o, sweep) <=
+                                                   start(b, sweep);
+                                        }),
+                         active.end());
+            for (auto o : active) {
+                bool overlap = true;
+                for (size_t i = 0; i < N && overlap; ++i) {
+                    overlap = start(o, i) < start(b, i) + count(b, i) &&
+                              start(b, i) < start(o, i) + count(o, i);
+                }
+                require(!overlap, "H5DistributedArray blocks overlap.");
+            }
+            active.push_back(b);
+        }
+        require(covered == total, "H5DistributedArray blocks do not cover the global array.");
+    }
+};
+
+} // namespace H5Wrapper
@@ -1,12 +1,18 @@
 #pragma once
-#include <algorithm> //std::find
+#include <algorithm> //std::find, std::max
+#include <atomic>
 #include <hdf5.h>
 #include <mpi.h>
+#include <stdexcept> //std::runtime_error
+#include <string>
 #include <sys/stat.h> //stat buffer
+#include <sys/statvfs.h>
 #include <vector>
 
 #include "is_parallel.hpp"
+#include "h5_attribute.hpp"
 #include "h5_location.hpp"
+#include "h5_mpi_info.hpp"
 #include "h5_property.hpp"
 
 #include "runtime_assert.hpp"
@@ -15,7 +21,7 @@ namespace H5Wrapper {
 
 
 //TODO: consider requiring an explicit close call instead of calling it in the destructor
-class H5File : public H5Location {
+class H5File : public H5Location, public H5AttributeHolder<H5File> {
 
 private:
     H5FileCreateProperty m_create_p;
@@ -62,12 +68,145 @@ public:
     ///
     static H5File create(const std::string&          name,
                          CreationFlag                flag,
-                         const H5FileCreateProperty& creation_property = H5FileCreateProperty(),
-                         const H5FileAccessProperty& access_property   = H5FileAccessProperty()) {
+                         const H5FileCreateProperty& creation_property =
+                             default_property<H5FileCreateProperty>(),
+                         const H5FileAccessProperty& access_property =
+                             default_property<H5FileAccessProperty>()) {
 
+        return H5File(name, flag, creation_property, effective_access(access_property));
+    }
+
+    ///
+    ///@brief Creates a new HDF5 file accessed through MPI-IO by the ranks of a communicator.
+    ///
+    ///@param name specifies the name of the file to be created.
+    ///@param flag parameter specifies the creation mode.
+    ///@param comm communicator of the ranks accessing the file, e.g. the I/O ranks of a node
+    ///@param hints MPI-IO hints, e.g. "striping_factor", "cb_nodes" or "romio_cb_write"
+    ///@param creation_property file creation property list
+    ///@return H5File a file identifier for the created file
+    ///
+    static H5File create(const std::string&          name,
+                         CreationFlag                flag,
+                         MPI_Comm                    comm,
+                         const H5MpiInfo&            hints             = H5MpiInfo(),
+                         const H5FileCreateProperty& creation_property =
+                             default_property<H5FileCreateProperty>()) {
+
+        H5FileAccessProperty access_property;
+        access_property.set_mpi(comm, hints);
         return H5File(name, flag, creation_property, access_property);
     }
 
+    ///
+    ///@brief Creates a new HDF5 file whose large objects start at multiples of the block size of
+    ///       the file system holding it, see file_system_block_size(), so that large dataset
+    ///       writes cover whole blocks. Metadata is aggregated in blocks of at least the same
+    ///       size. File systems which do not report their stripe size as block size (Lustre
+    ///       reports the block size of the storage targets) need the stripe size set explicitly
+    ///       with H5FileAccessProperty::set_alignment instead.
+    ///
+    ///@param name specifies the name of the file to be created.
+    ///@param flag parameter specifies the creation mode.
+    ///@param threshold smallest object in bytes which is aligned, zero for the block size
+    ///@param creation_property file creation property list
+    ///@param access_property file access property list, copied before the alignment is set
+    ///@return H5File a file identifier for the created file
+    ///
+    static H5File create_aligned(const std::string&          name,
+                                 CreationFlag                flag,
+                                 size_t                      threshold         = 0,
+                                 const H5FileCreateProperty& creation_property =
+                                     default_property<H5FileCreateProperty>(),
+                                 const H5FileAccessProperty& access_property =
+                                     default_property<H5FileAccessProperty>()) {
+        const size_t block   = file_system_block_size(name);
+        auto         aligned = access_property.copy();
+        aligned.set_alignment(threshold == 0 ? block : threshold, block);
+        aligned.set_meta_block_size(std::max(aligned.get_meta_block_size(), block));
+        return create(name, flag, creation_property, aligned);
+    }
+
+    ///
+    ///@brief Returns the block size statvfs reports for the file system holding a file. The
+    ///       directory of the file is queried, so the file does not need to exist. Throws
+    ///       std::runtime_error, also without DEBUG, if the directory can not be queried.
+    ///
+    ///@param name name of the file
+    ///@return size_t block size in bytes
+    ///
+    static size_t file_system_block_size(const std::string& name) {
+        const auto        slash = name.find_last_of('/');
+        const std::string dir   = slash == std::string::npos ? "."
+                                  : slash == 0               ? "/"
+                                                             : name.substr(0, slash);
+        struct statvfs    buffer;
+        if (statvfs(dir.c_str(), &buffer) != 0 || buffer.f_bsize == 0) {
+            throw std::runtime_error("H5File file_system_block_size fails.");
+        }
+        return buffer.f_bsize;
+    }
+
+    ///
+    ///@brief Creates a new HDF5 file held in memory by the core driver, e.g. for tests or for
+    ///       staging small outputs which are then shipped with to_image(). Without a backing
+    ///       store the name only identifies the file and nothing touches the disk.
+    ///
+    ///@param name name of the file, the file on disk written on close with a backing store
+    ///@param increment number of bytes the memory of the file grows by
+    ///@param backing_store write the contents to the named file when the file is closed
+    ///@param creation_property file creation property list
+    ///@return H5File a file identifier for the created file
+    ///
+    static H5File create_in_memory(const std::string&          name,
+                                   size_t                      increment =
+                                       H5FileAccessProperty::default_core_increment,
+                                   bool                        backing_store     = false,
+                                   const H5FileCreateProperty& creation_property =
+                                       default_property<H5FileCreateProperty>()) {
+        H5FileAccessProperty access_property;
+        access_property.set_core(increment, backing_store);
+        return H5File(name, CreationFlag::TRUNCATE, creation_property, access_property);
+    }
+
+    ///
+    ///@brief Opens a file image, e.g. one returned by to_image() and received from another rank,
+    ///       as a file held in memory. Nothing touches the disk, and changes made with
+    ///       READANDWRITE access do not modify the image.
+    ///
+    ///@param data first byte of the image
+    ///@param size size of the image in bytes
+    ///@param flag access mode of the file
+    ///@return H5File a file identifier for the open file
+    ///
+    static H5File
+    from_image(const void* data, size_t size, AccessFlag flag = AccessFlag::READ) {
+        auto                 lock = detail::library_lock();
+        H5FileAccessProperty access_property;
+        access_property.set_core(H5FileAccessProperty::default_core_increment, false);
+        access_property.set_file_image(data, size);
+
+        // files held in memory are told apart by name
+        static std::atomic<size_t> count{0};
+        const std::string          name = "h5wrapper_image_" + std::to_string(count++);
+
+        hid_t id = H5Fopen(name.c_str(), convert_flag(flag), ~access_property);
+        Utils::runtime_assert(id >= 0, "H5File from_image fails.");
+        return H5File(id, access_property);
+    }
+
+    ///
+    ///@brief Opens a file image held in a byte container.
+    ///
+    ///@param image bytes of the image
+    ///@param flag access mode of the file
+    ///@return H5File a file identifier for the open file
+    ///
+    static H5File from_image(const std::vector<unsigned char>& image,
+                             AccessFlag                        flag = AccessFlag::READ) {
+        return from_image(image.data(), image.size(), flag);
+    }
+
     ///
     ///@brief Opens an existing HDF5 file.
     ///
@@ -79,19 +218,34 @@ public:
     ///
     static H5File open(const std::string&          name,
                        AccessFlag                  flag,
-                       const H5FileAccessProperty& access_property = H5FileAccessProperty()) {
+                       const H5FileAccessProperty& access_property =
+                           default_property<H5FileAccessProperty>()) {
+        auto lock = detail::library_lock();
 
         Utils::runtime_assert(exists(name), "File does not exist");
-        
-        //TODO: Make less insane
-        if (is_parallel()){
-            access_property.store_mpi_info(MPI_COMM_WORLD, MPI_INFO_NULL);
-        }
 
-        hid_t id = H5Fopen(name.c_str(), convert_flag(flag), ~access_property);
+        auto effective = effective_access(access_property);
+
+        hid_t id = H5Fopen(name.c_str(), convert_flag(flag), ~effective);
         Utils::runtime_assert(id >= 0, "H5File open fails.");
 
-        return H5File(id);
+        return H5File(id, effective);
+    }
+
+    ///
+    ///@brief Opens an existing HDF5 file through MPI-IO by the ranks of a communicator.
+    ///
+    ///@param name specifies the name of the file to be opened.
+    ///@param flag parameter specifies whether the file will be opened in APPEND or READ-only mode
+    ///@param comm communicator of the ranks accessing the file
+    ///@param hints MPI-IO hints passed to MPI_File_open
+    ///@return H5File a file identifier for the open file
+    ///
+    static H5File
+    open(const std::string& name, AccessFlag flag, MPI_Comm comm, const H5MpiInfo& hints) {
+        H5FileAccessProperty access_property;
+        access_property.set_mpi(comm, hints);
+        return open(name, flag, access_property);
     }
 
     /*
@@ -103,22 +257,34 @@ public:
     ///@return H5File Returns a new file identifier if successful.
     ///
     static H5File reopen(const H5File& file) {
-        hid_t id = H5Freopen(~file);
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Freopen(~file);
         Utils::runtime_assert(id >= 0, "H5File reopen fails.");
         return H5File(id);
     }
     */
 
     ///
-    ///@brief Terminates access to an HDF5 file.
+    ///@brief Terminates access to an HDF5 file. The groups kept open by the path index are
+    ///       closed as well.
     ///
     ///@param file Identifier of a file to terminate access to.
     ///
     void close() {
-        hid_t id = H5Fclose(this->get_handle());
-        Utils::runtime_assert(id >= 0, "H5File close fails.");
+        if (path_index()) { path_index()->close_groups(); }
+        H5Object::close();
     }
 
+    ///
+    ///@brief Attaches a path index to the file. Groups created or opened from this handle
+    ///       afterwards share the index, which then answers H5Group::exists for every path created,
+    ///       opened or found through them. Copies of the handle made before the call do not see
+    ///       the index. The groups it keeps open are closed by close(), or once the last handle
+    ///       sharing the index is destroyed.
+    ///
+    ///
+    void enable_path_index() { this->attach_path_index(); }
+
     ///
     ///@brief Determines whether a file is in the HDF5 format.
     ///
@@ -127,6 +293,7 @@ public:
     ///@return if the file name is not an HDF5 file.
     ///
     static bool is_hdf5(const std::string& name) {
+        auto lock = detail::library_lock();
 
         
         htri_t query = H5Fis_hdf5(name.c_str());
@@ -154,12 +321,84 @@ public:
     ///@return size_t size of the filen in bytes.
     ///
     size_t get_filesize() const {
+        auto    lock = detail::library_lock();
         hsize_t size;
         herr_t  err = H5Fget_filesize(this->get_handle(), &size);
         Utils::runtime_assert(err >= 0, "H5File get filesize fails.");
         return size_t(size);
     }
 
+    struct MetadataCacheStats {
+        double hit_rate;       // hits per access since the last reset, zero without accesses
+        size_t max_size;       // current maximum size of the cache in bytes
+        size_t min_clean_size; // bytes kept clean for eviction without writing
+        size_t current_size;   // bytes of metadata currently cached
+        size_t entries;        // number of cached entries
+    };
+
+    ///
+    ///@brief Returns the hit rate and size of the metadata cache of the file, see
+    ///       H5FileAccessProperty::set_metadata_cache. The hit rate counts the accesses since
+    ///       reset_mdc_stats(), a cache resizing adaptively resets it at the end of every epoch
+    ///       of 50000 accesses.
+    ///
+    ///@return MetadataCacheStats the statistics
+    ///
+    MetadataCacheStats get_mdc_stats() const {
+        auto               lock = detail::library_lock();
+        MetadataCacheStats ret;
+        herr_t             err = H5Fget_mdc_hit_rate(this->get_handle(), &ret.hit_rate);
+        Utils::runtime_assert(err >= 0, "H5File get_mdc_stats fails.");
+        int entries;
+        err = H5Fget_mdc_size(
+            this->get_handle(), &ret.max_size, &ret.min_clean_size, &ret.current_size, &entries);
+        Utils::runtime_assert(err >= 0, "H5File get_mdc_stats fails.");
+        ret.entries = size_t(entries);
+        return ret;
+    }
+
+    ///
+    ///@brief Resets the hit rate statistics of the metadata cache, e.g. before a phase of the
+    ///       workflow which is to be measured.
+    ///
+    ///
+    void reset_mdc_stats() {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Freset_mdc_hit_rate_stats(this->get_handle());
+        Utils::runtime_assert(err >= 0, "H5File reset_mdc_stats fails.");
+    }
+
+    ///
+    ///@brief Checks if the file evicts the metadata of objects from the metadata cache when they
+    ///       are closed, as set in the access property list it was opened with, see
+    ///       H5FileAccessProperty::set_evict_on_close.
+    ///
+    ///@return true if evicted on close
+    ///
+    bool evict_on_close() const {
+        // H5Fget_access_plist does not report the setting before HDF5 1.12
+        return m_access_p.get_evict_on_close();
+    }
+
+    ///
+    ///@brief Serializes the whole file into a byte buffer, which can be written elsewhere, sent
+    ///       over MPI or opened again with from_image(). Works for files of any driver, the file
+    ///       is flushed first.
+    ///
+    ///@return std::vector<unsigned char> the file image
+    ///
+    std::vector<unsigned char> to_image() const {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Fflush(this->get_handle(), H5F_SCOPE_LOCAL);
+        Utils::runtime_assert(err >= 0, "H5File to_image flush fails.");
+        ssize_t size = H5Fget_file_image(this->get_handle(), nullptr, 0);
+        Utils::runtime_assert(size >= 0, "H5File to_image fails.");
+        std::vector<unsigned char> ret(static_cast<size_t>(size));
+        size = H5Fget_file_image(this->get_handle(), ret.data(), ret.size());
+        Utils::runtime_assert(size >= 0, "H5File to_image fails.");
+        return ret;
+    }
+
     ///
     ///@brief Returns a file creation property list identifier.
     ///
@@ -168,7 +407,8 @@ public:
     const H5FileCreateProperty& get_creation_property() const { return m_create_p; }
 
     ///
-    ///@brief Get the access property list identifier.
+    ///@brief Get the access property list identifier. It may be the list shared by all files
+    ///       opened with the default access property, which is a read-only view.
     ///
     ///@return const H5FileAccessProperty& access property
     ///
@@ -205,6 +445,7 @@ public:
     ///@return size_t Returns the number of open objects if successful.
     ///
     size_t get_object_count() const {
+        auto lock = detail::library_lock();
         auto size = H5Fget_obj_count(this->get_handle(), H5F_OBJ_ALL);
         Utils::runtime_assert(size >= 0, "H5File get object count fails.");
         return size_t(size);
@@ -216,6 +457,7 @@ public:
     ///@return std::vector<hid_t> list of open object identifiers.
     ///
     std::vector<hid_t> get_open_object_ids() const {
+        auto lock = detail::library_lock();
 
         size_t             count = get_object_count();
         std::vector<hid_t> ids(count);
@@ -229,12 +471,41 @@ private:
            CreationFlag                flag,
            const H5FileCreateProperty& creation_property,
            const H5FileAccessProperty& access_property)
-        : H5Location(file_create(name, flag, creation_property, access_property))
+        : H5Location(file_create(name, flag, creation_property, access_property), &H5Fclose)
         , m_create_p(creation_property)
         , m_access_p(access_property) {}
 
-    explicit H5File(hid_t id)
-        : H5Location(id) {}
+    H5File(hid_t id, const H5FileAccessProperty& access_property)
+        : H5Location(id, &H5Fclose)
+        , m_access_p(access_property) {}
+
+    ///
+    ///@brief Returns the access property list a file is actually opened with. If MPI has been
+    ///       initialized and the list still selects the default serial driver without an explicit
+    ///       set_serial() call, a copy of it using MPI-IO on MPI_COMM_WORLD is returned. The given
+    ///       list itself is never modified. The list derived from the default access property is
+    ///       created once per process, so opening files with the defaults does not duplicate the
+    ///       communicator every time.
+    ///
+    ///@param access_property file access property list given by the user
+    ///@return H5FileAccessProperty the effective access property list
+    ///
+    static H5FileAccessProperty effective_access(const H5FileAccessProperty& access_property) {
+        if (!is_parallel() || access_property.is_serial()) { return access_property; }
+        if (~access_property == ~default_property<H5FileAccessProperty>()) {
+            // left to the library to free, like the other shared default lists
+            static const H5FileAccessProperty world = [] {
+                H5FileAccessProperty fapl;
+                fapl.set_mpi(MPI_COMM_WORLD);
+                return H5FileAccessProperty(fapl.release(), H5Object::borrowed);
+            }();
+            return world;
+        }
+        if (access_property.get_driver() != H5FD_SEC2) { return access_property; }
+        auto ret = access_property.copy();
+        ret.set_mpi(MPI_COMM_WORLD);
+        return ret;
+    }
 
     ///
     ///@brief Gets the intent of the file which was flagged on creation.
@@ -249,12 +520,33 @@ private:
     ///         the reader process must also open the file with the H5F_ACC_RDONLY flag.
     ///
     unsigned get_intent() const {
+        auto     lock = detail::library_lock();
         unsigned intent;
         herr_t   err = H5Fget_intent(this->get_handle(), &intent);
         Utils::runtime_assert(err >= 0, "H5File get intent fails");
         return intent;
     }
 
+    ///
+    ///@brief Checks that a page buffer requested by the access property list can be used with
+    ///       the creation property list: the file has to use paged aggregation and the buffer
+    ///       has to hold at least one page. Throws std::runtime_error, also without DEBUG.
+    ///
+    ///@param creation_property file creation property list
+    ///@param access_property file access property list
+    ///
+    static void check_page_buffer(const H5FileCreateProperty& creation_property,
+                                  const H5FileAccessProperty& access_property) {
+        const size_t bytes = access_property.get_page_buffer_size();
+        if (bytes == 0) { return; }
+        if (creation_property.get_file_space_strategy() != H5F_FSPACE_STRATEGY_PAGE) {
+            throw std::runtime_error("H5File page buffer needs a file with paged aggregation.");
+        }
+        if (bytes < creation_property.get_file_space_page_size()) {
+            throw std::runtime_error("H5File page buffer is smaller than one page.");
+        }
+    }
+
     ///
     ///@brief Createas a new H5File
     ///
@@ -268,12 +560,9 @@ private:
                              CreationFlag                flag,
                              const H5FileCreateProperty& creation_property,
                              const H5FileAccessProperty& access_property) {
+        auto lock = detail::library_lock();
 
-        //TODO: Make less insane
-        if (is_parallel()){
-            access_property.store_mpi_info(MPI_COMM_WORLD, MPI_INFO_NULL);
-        }
-
+        check_page_buffer(creation_property, access_property);
         hid_t id =
             H5Fcreate(name.c_str(), convert_flag(flag), ~creation_property, ~access_property);
         Utils::runtime_assert(id >= 0, "H5File file create fails.");
@@ -4,12 +4,14 @@
 
 #include "runtime_assert.hpp"
 #include "array_cast.hpp"
+#include "h5_library_lock.hpp"
 
 namespace H5Wrapper{
 
 struct H5{
 
     static bool is_valid(hid_t obj)  {
+        auto lock = detail::library_lock();
 
         auto ret = H5Iis_valid(obj);
         Utils::runtime_assert(ret >= 0, "H5Is_valid fails.");
@@ -19,6 +21,7 @@ struct H5{
 
 
     static hid_t type_copy(hid_t type_id) {
+        auto lock = detail::library_lock();
 
         auto ret = H5Tcopy(type_id);
         Utils::runtime_assert(ret >= 0, "H5 type copy fails.");
@@ -26,20 +29,38 @@ struct H5{
     } 
 
 
+    static bool type_equal(hid_t type1_id, hid_t type2_id) {
+        auto lock = detail::library_lock();
+        auto ret  = H5Tequal(type1_id, type2_id);
+        Utils::runtime_assert(ret >= 0, "H5 type equal fails.");
+        return ret > 0;
+    }
+
+
+    static void type_lock(hid_t type_id) {
+        auto lock = detail::library_lock();
+        auto err  = H5Tlock(type_id);
+        Utils::runtime_assert(err >= 0, "H5 type lock fails.");
+    }
+
+
     static void type_close(hid_t type_id) {
-        auto err = H5Tclose(type_id);
+        auto lock = detail::library_lock();
+        auto err  = H5Tclose(type_id);
         Utils::runtime_assert(err >= 0, "H5 type close fails.");
     }
 
 
     static void dataspace_close(hid_t dataspace_id) {
-        auto err = H5Sclose(dataspace_id);
+        auto lock = detail::library_lock();
+        auto err  = H5Sclose(dataspace_id);
         Utils::runtime_assert(err >= 0, "H5 dataspace close fails.");
     }
 
     template<size_t N>
     static hid_t create_simple_dataspace(const std::array<size_t, N>& current_dims, 
                                          const std::array<size_t, N>& max_dims) {
+        auto lock = detail::library_lock();
 
         
 
@@ -1,14 +1,15 @@
 #pragma once
 
-#include <cstring>
 #include <hdf5.h>
+#include <string>
 
+#include "h5_attribute.hpp"
 #include "h5_location.hpp"
 #include "h5_property.hpp"
 
 namespace H5Wrapper {
 
-class H5Group : public H5Location {
+class H5Group : public H5Location, public H5AttributeHolder<H5Group> {
 
 public:
     H5Group() = default;
@@ -26,16 +27,24 @@ public:
     static H5Group create(const H5Location&            loc,
                           const std::string&           name,
                           bool                         create_intermediate = true,
-                          const H5GroupCreateProperty& group_cr_prop = H5GroupCreateProperty(),
-                          const H5GroupAccessProperty& group_ac_prop = H5GroupAccessProperty()) {
+                          const H5GroupCreateProperty& group_cr_prop =
+                              default_property<H5GroupCreateProperty>(),
+                          const H5GroupAccessProperty& group_ac_prop =
+                              default_property<H5GroupAccessProperty>()) {
 
         H5LinkCreateProperty link_prop;
         if (create_intermediate) { link_prop.set_create_intermediate_groups(); }
-        return H5Group(loc, name, link_prop, group_cr_prop, group_ac_prop);
+        H5Group group(loc, name, link_prop, group_cr_prop, group_ac_prop);
+        group.inherit_path_index(loc, name);
+        if (default_access(group_ac_prop)) { group.cache_in_path_index(); }
+        return group;
     }
 
     ///
-    ///@brief Opens an existing group with a group access property list.
+    ///@brief Opens an existing group with a group access property list. If the file has a path
+    ///       index, a path it knows as an object other than a group is refused without touching
+    ///       the file, and a group opened before with the default access properties is shared
+    ///       instead of being opened again.
     ///
     ///@param loc  File or group identifier specifying the location of the group to be opened
     ///@param name Name of the group to open
@@ -44,32 +53,55 @@ public:
     ///
     static H5Group open(const H5Location&     loc,
                         const std::string&    name,
-                        H5GroupAccessProperty group_ac_prop = H5GroupAccessProperty()) {
+                        const H5GroupAccessProperty& group_ac_prop =
+                            default_property<H5GroupAccessProperty>()) {
+        auto       lock     = detail::library_lock();
+        const bool defaults = default_access(group_ac_prop);
+        if (const auto& index = loc.path_index()) {
+            auto path = loc.absolute_path(name);
+            auto type = index->type(path);
+            Utils::runtime_assert(type == H5O_TYPE_UNKNOWN || type == H5O_TYPE_GROUP,
+                                  "H5Group open fails. Not a group.");
+            hid_t cached = defaults ? index->cached_group(path) : H5I_INVALID_HID;
+            if (cached > 0) {
+                H5Group group(cached, Policy::WITHOUT_WARD);
+                group.inherit_path_index(loc, name);
+                return group;
+            }
+        }
         hid_t id = H5Gopen(~loc, name.c_str(), ~group_ac_prop);
         Utils::runtime_assert(id >= 0, "H5Group open fails.");
-        return H5Group(id);
+        H5Group group(id);
+        group.inherit_path_index(loc, name);
+        if (defaults) { group.cache_in_path_index(); }
+        return group;
     }
 
     ///
-    ///@brief Queries if a group exists
+    ///@brief Queries if a group exists. If the file has a path index, paths found in the index
+    ///       are answered without touching the file and paths found in the file are added to it.
     ///
     ///@param loc  File or group identifier specifying the location of the group to be queried
     ///@param name Name of the group to query
     ///@return bool true if exists, false otherwise
     ///
-    static bool exists(const H5Location& loc, std::string name) {
+    static bool exists(const H5Location& loc, const std::string& name) {
 
-        return H5Lexists_safe(~loc, name.c_str()) == 1;
+        const auto& index = loc.path_index();
+        if (!index) { return path_exists(~loc, name); }
+
+        auto path = loc.absolute_path(name);
+        if (index->contains(path)) { return true; }
+        if (!path_exists(~loc, name)) { return false; }
+        index->insert_with_parents(path);
+        return true;
     }
 
     ///
     ///@brief Closes the specified group.
     ///
     ///
-    void close() {
-        herr_t err = H5Gclose(this->get_handle());
-        Utils::runtime_assert(err >= 0, "H5Group close fails.");
-    }
+    void close() { H5Object::close(); }
 
 private:
     H5Group(const H5Location&            loc,
@@ -77,16 +109,23 @@ private:
             const H5LinkCreateProperty&  link_p,
             const H5GroupCreateProperty& group_cr_p,
             const H5GroupAccessProperty& group_ac_p)
-        : H5Location(group_create(loc, path, link_p, group_cr_p, group_ac_p)) {}
+        : H5Location(group_create(loc, path, link_p, group_cr_p, group_ac_p), &H5Gclose) {}
 
-    explicit H5Group(hid_t id)
-        : H5Location(id) {}
+    explicit H5Group(hid_t id, Policy policy = Policy::WITH_WARD)
+        : H5Location(id, &H5Gclose, policy) {}
+
+    // only groups opened with the default access properties are shared through the path index
+    static bool default_access(const H5GroupAccessProperty& group_ac_prop) {
+        return ~group_ac_prop == H5P_DEFAULT ||
+               ~group_ac_prop == ~default_property<H5GroupAccessProperty>();
+    }
 
     static hid_t group_create(const H5Location&            loc,
                               const std::string&           path,
                               const H5LinkCreateProperty&  link_p,
                               const H5GroupCreateProperty& group_cr_p,
                               const H5GroupAccessProperty& group_ac_p) {
+        auto lock = detail::library_lock();
 
         auto id = H5Gcreate(~loc, path.c_str(), ~link_p, ~group_cr_p, ~group_ac_p);
         Utils::runtime_assert(id >= 0, "Group create fails.");
@@ -94,32 +133,27 @@ private:
     }
 
     ///
-    ///@brief Extends the H5Lexists to work with paths
+    ///@brief Extends the H5Lexists to work with paths by checking every prefix of the path in
+    ///       turn, which H5Lexists requires. No intermediate group is opened.
     ///
     ///@param base base location, typically a file id
     ///@param path the path to check existence of
-    ///@return int 1 if whole path exists 0 otherwise
+    ///@return bool true if whole path exists false otherwise
     ///
-    static int H5Lexists_safe(hid_t base, const char* path) {
-        hid_t last = base, next;
-        char* pch;
-        char  pathc[2048];
-        strcpy(pathc, path);
-        pch = strtok(pathc, "/");
-        while (pch != NULL) {
-            int exists = H5Lexists(last, pch, H5P_DEFAULT);
-            if (!exists) {
-                if (last != base) H5Gclose(last);
-                return 0;
-            } else {
-                next = H5Gopen(last, pch, H5P_DEFAULT);
-                if (last != base) H5Gclose(last);
-                last = next;
-            }
-            pch = strtok(NULL, "/");
-        }
-        if (last != base) H5Gclose(last);
-        return 1;
+    static bool path_exists(hid_t base, const std::string& path) {
+        auto        lock = detail::library_lock();
+        std::string prefix;
+        prefix.reserve(path.size());
+        if (!path.empty() && path[0] == '/') { prefix += '/'; }
+
+        bool exists = true;
+        detail::for_each_path_component(path, [&](std::string_view component) {
+            if (!exists) { return; }
+            if (!prefix.empty() && prefix.back() != '/') { prefix += '/'; }
+            prefix += component;
+            exists = H5Lexists(base, prefix.c_str(), H5P_DEFAULT) > 0;
+        });
+        return exists;
     }
 };
 
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <mutex>
+
+namespace H5Wrapper {
+
+namespace detail {
+
+///
+///@brief Mutex serializing the HDF5 calls of the process. Unless HDF5 is built thread-safe, only
+///       one thread may be inside the library at a time, e.g. while an H5AsyncWriter writes on
+///       its I/O thread. Recursive, as the entry points of the wrapper call each other.
+///
+///@return std::recursive_mutex& the mutex, the same in every translation unit
+///
+inline std::recursive_mutex& library_mutex() {
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
+///
+///@brief Locks library_mutex(). Every member of the wrapper calling HDF5, including the
+///       reference counting of handle copies and the destructors, holds the lock for the call.
+///
+///@return std::unique_lock<std::recursive_mutex> the held lock
+///
+inline std::unique_lock<std::recursive_mutex> library_lock() {
+    return std::unique_lock<std::recursive_mutex>(library_mutex());
+}
+
+} // namespace detail
+
+} // namespace H5Wrapper
@@ -2,17 +2,94 @@
 
 #include <hdf5.h>
 
-#include <vector>
+#include <exception> //std::exception_ptr
+#include <memory>    //std::shared_ptr
 #include <string>
+#include <type_traits> //std::remove_reference_t
+#include <vector>
 
 #include "h5_object.hpp"
+#include "h5_path_index.hpp"
 #include "h5_property.hpp"
 //#include "h5_data.hpp"
 
 
 namespace H5Wrapper {
 
+namespace detail {
+
+// Object info queries restricted to the basic fields (type, address, reference count), which do
+// not require reading the whole object header.
+
+#if H5_VERSION_GE(1, 12, 0)
+
+static inline H5O_type_t object_type(hid_t loc, const char* name) {
+    auto        lock = detail::library_lock();
+    H5O_info2_t info;
+    herr_t      err = H5Oget_info_by_name3(loc, name, &info, H5O_INFO_BASIC, H5P_DEFAULT);
+    Utils::runtime_assert(err >= 0, "H5Oget_info_by_name fails.");
+    return info.type;
+}
+
+static inline herr_t visit_objects(hid_t obj, H5O_iterate2_t op, void* op_data) {
+    auto lock = detail::library_lock();
+    return H5Ovisit3(obj, H5_INDEX_NAME, H5_ITER_INC, op, op_data, H5O_INFO_BASIC);
+}
+
+#elif H5_VERSION_GE(1, 10, 3)
+
+static inline H5O_type_t object_type(hid_t loc, const char* name) {
+    auto       lock = detail::library_lock();
+    H5O_info_t info;
+    herr_t     err = H5Oget_info_by_name2(loc, name, &info, H5O_INFO_BASIC, H5P_DEFAULT);
+    Utils::runtime_assert(err >= 0, "H5Oget_info_by_name fails.");
+    return info.type;
+}
+
+static inline herr_t visit_objects(hid_t obj, H5O_iterate_t op, void* op_data) {
+    auto lock = detail::library_lock();
+    return H5Ovisit2(obj, H5_INDEX_NAME, H5_ITER_INC, op, op_data, H5O_INFO_BASIC);
+}
+
+#else
+
+static inline H5O_type_t object_type(hid_t loc, const char* name) {
+    auto       lock = detail::library_lock();
+    H5O_info_t info;
+    herr_t     err = H5Oget_info_by_name(loc, name, &info, H5P_DEFAULT);
+    Utils::runtime_assert(err >= 0, "H5Oget_info_by_name fails.");
+    return info.type;
+}
+
+static inline herr_t visit_objects(hid_t obj, H5O_iterate_t op, void* op_data) {
+    auto lock = detail::library_lock();
+    return H5Ovisit(obj, H5_INDEX_NAME, H5_ITER_INC, op, op_data);
+}
 
+#endif
+
+static inline bool object_exists(hid_t loc, const char* name) {
+    auto   lock   = detail::library_lock();
+    htri_t exists = H5Oexists_by_name(loc, name, H5P_DEFAULT);
+    return exists > 0;
+}
+
+// passed to the HDF5 iteration callbacks, which store the exception of the operation instead of
+// letting it unwind through the library
+template <class Op> struct IterationData {
+    Op&                op;
+    std::exception_ptr error;
+};
+
+} // namespace detail
+
+///
+///@brief Name and type (hard, soft or external) of a link.
+///
+struct H5LinkInfo {
+    std::string name;
+    H5L_type_t  type;
+};
 
 class H5Location : public H5Object{
 
@@ -23,8 +100,8 @@ public:
 
 protected:
 
-    explicit H5Location(hid_t id)
-    : H5Object(id) {
+    H5Location(hid_t id, closer_type closer, Policy policy = Policy::WITH_WARD)
+    : H5Object(id, closer, policy) {
 
         auto type = this->get_type();
 
@@ -33,7 +110,70 @@ protected:
         }
     }
 
+    ///
+    ///@brief Shares the path index of the parent location, if it has one, and records the
+    ///       absolute path of this location.
+    ///
+    ///@param parent location this location was created or opened from
+    ///@param name absolute or relative path of this location in the parent
+    ///
+    void inherit_path_index(const H5Location& parent, const std::string& name) {
+        if (!parent.m_path_index) { return; }
+        m_path_index = parent.m_path_index;
+        m_path       = parent.absolute_path(name);
+        m_path_index->insert_with_parents(m_path, H5O_TYPE_GROUP);
+    }
+
+    ///
+    ///@brief Attaches a new, empty path index to this location, which has to be the root group.
+    ///
+    ///
+    void attach_path_index() {
+        m_path_index = std::make_shared<H5PathIndex>();
+        m_path       = "/";
+    }
+
+    ///
+    ///@brief Keeps this group open in the path index, if the location has one, to be shared by
+    ///       later opens of its path.
+    ///
+    ///
+    void cache_in_path_index() const {
+        if (m_path_index) { m_path_index->cache_group(m_path, this->get_handle()); }
+    }
+
 public:
+    ///
+    ///@brief Returns the path index shared by the locations of the file, if enabled.
+    ///
+    ///@return const std::shared_ptr<H5PathIndex>& the index or nullptr
+    ///
+    const std::shared_ptr<H5PathIndex>& path_index() const { return m_path_index; }
+
+    ///
+    ///@brief Resolves a name relative to this location to a normalized absolute path. Only
+    ///       meaningful when the location has a path index.
+    ///
+    ///@param name absolute or relative path
+    ///@return std::string absolute path
+    ///
+    std::string absolute_path(const std::string& name) const {
+        return detail::join_path(m_path, name);
+    }
+
+    ///
+    ///@brief Deletes a link, e.g. to a group or dataset, in this location. The object is freed
+    ///       once no link refers to it and no handle to it is open. The path and everything below
+    ///       it are erased from the path index.
+    ///
+    ///@param name absolute or relative name of the link
+    ///
+    void remove_link(const std::string& name) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Ldelete(~(*this), name.c_str(), H5P_DEFAULT);
+        Utils::runtime_assert(err >= 0, "H5Location remove_link fails.");
+        if (m_path_index) { m_path_index->erase(absolute_path(name)); }
+    }
 
     ///
     ///@brief Gets the number of links (child nodes) in a group
@@ -41,12 +181,47 @@ public:
     ///@return size_t number of links
     ///
     size_t nlinks() const {
+        auto       lock = detail::library_lock();
         H5G_info_t info;
         auto       err = H5Gget_info(~(*this), &info);
         Utils::runtime_assert(err >= 0, "Failed to get group info.");
         return info.nlinks;
     }
 
+    ///
+    ///@brief Calls op(name, link_type) for every link in the current location in increasing name
+    ///       order. The links are visited in a single pass with H5Literate. An exception thrown
+    ///       by op stops the iteration and is rethrown once HDF5 has returned.
+    ///
+    ///@param op callable taking (const char* name, H5L_type_t type)
+    ///
+    template <class Op> void for_each_link(Op&& op) const {
+        auto lock = detail::library_lock();
+
+        using op_type = std::remove_reference_t<Op>;
+
+        // exceptions must not unwind through the C library
+        detail::IterationData<op_type> data{op, nullptr};
+
+        // generic so that it converts to the link iteration callback of any HDF5 version
+        auto callback = [](hid_t, const char* name, const auto* info, void* op_data) -> herr_t {
+            auto& iteration = *static_cast<detail::IterationData<op_type>*>(op_data);
+            try {
+                iteration.op(name, info->type);
+            } catch (...) {
+                iteration.error = std::current_exception();
+                return -1;
+            }
+            return 0;
+        };
+
+        hsize_t idx = 0;
+        herr_t  err = H5Literate(
+            ~(*this), H5_INDEX_NAME, H5_ITER_INC, &idx, callback, static_cast<void*>(&data));
+        if (data.error) { std::rethrow_exception(data.error); }
+        Utils::runtime_assert(err >= 0, "H5Location for_each_link fails.");
+    }
+
     ///
     ///@brief Returns the names of all the links in the current location.
     ///
@@ -55,48 +230,120 @@ public:
     std::vector<std::string> link_names() const {
 
         std::vector<std::string> names;
+        names.reserve(nlinks());
 
-        for (size_t i = 0; i < nlinks(); i++) {
+        for_each_link([&names](const char* name, H5L_type_t) { names.emplace_back(name); });
 
-            ssize_t size =
-                1 + H5Lget_name_by_idx(
-                        ~(*this), ".", H5_INDEX_NAME, H5_ITER_INC, i, NULL, 0, H5P_DEFAULT);
+        return names;
+    }
 
-            char* name = new char[size];
+    ///
+    ///@brief Returns the names and types of all the links in the current location.
+    ///
+    ///@return std::vector<H5LinkInfo> Names and types of the links in this location.
+    ///
+    std::vector<H5LinkInfo> link_infos() const {
+
+        std::vector<H5LinkInfo> infos;
+        infos.reserve(nlinks());
+
+        for_each_link([&infos](const char* name, H5L_type_t type) {
+            infos.push_back(H5LinkInfo{std::string(name), type});
+        });
+
+        return infos;
+    }
+
+    ///
+    ///@brief Calls op(name, object_type) for every object in the current location without opening
+    ///       the objects. Objects are classified from their object header info, soft links are
+    ///       followed and dangling soft links and external links are skipped.
+    ///
+    ///@param op callable taking (const char* name, H5O_type_t type). An exception thrown by it
+    /// stops the iteration and is rethrown once HDF5 has returned.
+    ///@param recursive if true, visits the whole hierarchy below this location with H5Ovisit and
+    /// passes paths relative to this location. Objects with several links are visited once.
+    ///
+    template <class Op> void for_each_object(Op&& op, bool recursive = false) const {
 
-            size = H5Lget_name_by_idx(
-                ~(*this), ".", H5_INDEX_NAME, H5_ITER_INC, i, name, size_t(size), H5P_DEFAULT);
+        using op_type = std::remove_reference_t<Op>;
 
-            names.push_back(std::string(name));
+        if (recursive) {
 
-            delete[] name;
+            detail::IterationData<op_type> data{op, nullptr};
+
+            auto callback = [](hid_t, const char* name, const auto* info, void* op_data) -> herr_t {
+                // skip the location itself
+                if (name[0] == '.' && name[1] == '\0') { return 0; }
+                auto& iteration = *static_cast<detail::IterationData<op_type>*>(op_data);
+                try {
+                    iteration.op(name, info->type);
+                } catch (...) {
+                    iteration.error = std::current_exception();
+                    return -1;
+                }
+                return 0;
+            };
+
+            herr_t err = detail::visit_objects(~(*this), callback, static_cast<void*>(&data));
+            if (data.error) { std::rethrow_exception(data.error); }
+            Utils::runtime_assert(err >= 0, "H5Location for_each_object fails.");
+            return;
         }
-        return names;
+
+        // the exceptions of op and of the type queries are passed on by for_each_link
+
+        hid_t loc = ~(*this);
+        for_each_link([loc, &op](const char* name, H5L_type_t type) {
+            if (type == H5L_TYPE_EXTERNAL) { return; }
+            if (type == H5L_TYPE_SOFT && !detail::object_exists(loc, name)) { return; }
+            op(name, detail::object_type(loc, name));
+        });
     }
 
     ///
     ///@brief Returns the names of all the datasets in the current location.
     ///
+    ///@param recursive if true, returns the paths of all datasets below this location
     ///@return std::vector<std::string> Names of the datasets.
     ///
-    std::vector<std::string> dataset_names() const {
-        std::vector<std::string> links = link_names();
-        std::vector<std::string> ret;
-        for (auto l : links){
-            
-            H5Object obj(
-                H5Oopen(~(*this), l.c_str(), ~H5LinkAccessProperty())
-            );
-            
-            if (obj.get_type() == H5Object::Type::DATASET){
-                ret.push_back(l);
-            }
+    std::vector<std::string> dataset_names(bool recursive = false) const {
+        return object_names(H5O_TYPE_DATASET, recursive);
+    }
 
-        }
-        return ret;
-    }    
+    ///
+    ///@brief Returns the names of all the groups in the current location.
+    ///
+    ///@param recursive if true, returns the paths of all groups below this location
+    ///@return std::vector<std::string> Names of the groups.
+    ///
+    std::vector<std::string> group_names(bool recursive = false) const {
+        return object_names(H5O_TYPE_GROUP, recursive);
+    }
 
+    ///
+    ///@brief Returns the names of all the committed datatypes in the current location.
+    ///
+    ///@param recursive if true, returns the paths of all committed datatypes below this location
+    ///@return std::vector<std::string> Names of the committed datatypes.
+    ///
+    std::vector<std::string> datatype_names(bool recursive = false) const {
+        return object_names(H5O_TYPE_NAMED_DATATYPE, recursive);
+    }
+
+private:
+    std::shared_ptr<H5PathIndex> m_path_index;
+    std::string                  m_path;
 
+    std::vector<std::string> object_names(H5O_type_t type, bool recursive) const {
+        std::vector<std::string> ret;
+        for_each_object(
+            [&ret, type](const char* name, H5O_type_t t) {
+                if (t == type) { ret.emplace_back(name); }
+            },
+            recursive);
+        return ret;
+    }
 };
 
 } // namespace H5Wrapper
\ No newline at end of file
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <iterator> //std::data, std::size
+#include <type_traits>
+#include <utility> //std::declval
+#include <vector>
+
+#include "h5_dataspace.hpp"
+#include "h5_dataspace_hyperslab.hpp"
+
+#include "runtime_assert.hpp"
+
+namespace H5Wrapper {
+
+namespace detail {
+
+template <class C, class = void> struct is_contiguous_container : std::false_type {};
+
+template <class C>
+struct is_contiguous_container<C,
+                               std::void_t<decltype(std::data(std::declval<C&>())),
+                                           decltype(std::size(std::declval<C&>()))>>
+    : std::bool_constant<std::is_pointer_v<decltype(std::data(std::declval<C&>()))> &&
+                         !std::is_array_v<C>> {};
+
+///
+///@brief True for types with std::data and std::size, e.g. std::vector, std::array or std::span.
+///       Built-in arrays are excluded, they keep decaying to pointers.
+///
+template <class C>
+static constexpr bool is_contiguous_container_v = is_contiguous_container<C>::value;
+
+} // namespace detail
+
+///
+///@brief Strided N-dimensional view of memory, similar to a std::mdspan with a strided layout.
+///       Element (i_0, ..., i_n-1) of the view is
+///       data()[i_0 * stride_0 + ... + i_n-1 * stride_n-1].
+///       The view describes the memory side of a read or write, so that the matching memory
+///       dataspace is derived (and cached by H5Dataset) instead of being built by hand. The
+///       strides are in elements and have to describe a row-major layout: every stride but the
+///       last two is a multiple of the next one, and the rows of a dimension do not overlap.
+///       This covers sub-blocks of larger arrays, e.g. the interior of a ghost-cell padded block,
+///       and every k-th element of the innermost dimension. The view does not own the memory.
+///
+///@tparam T element type, const for views which are only written to a dataset
+///
+template <class T> class H5MemoryView {
+
+public:
+    using dims_array = std::vector<size_t>;
+
+    ///
+    ///@brief Construct a view of contiguous row-major memory.
+    ///
+    ///@param data pointer to the first element
+    ///@param extents number of elements in each dimension
+    ///
+    H5MemoryView(T* data, const dims_array& extents)
+        : H5MemoryView(data, extents, row_major_strides(extents)) {}
+
+    ///
+    ///@brief Construct a strided view.
+    ///
+    ///@param data pointer to the first element of the view
+    ///@param extents number of elements in each dimension
+    ///@param strides distance in elements between consecutive indices of each dimension
+    ///
+    H5MemoryView(T* data, const dims_array& extents, const dims_array& strides)
+        : m_data(data)
+        , m_extents(extents)
+        , m_strides(strides) {
+        Utils::runtime_assert(valid_strides(m_extents, m_strides), "Invalid H5MemoryView strides.");
+    }
+
+    ///
+    ///@brief Views of non-const elements convert to views of const elements.
+    ///
+    template <class U, class = std::enable_if_t<std::is_same_v<const U, T>>>
+    H5MemoryView(const H5MemoryView<U>& other)
+        : m_data(other.data())
+        , m_extents(other.extents())
+        , m_strides(other.strides()) {}
+
+    ///
+    ///@brief Returns a view of a block of a contiguous row-major array, e.g. the interior of a
+    ///       block padded with ghost cells.
+    ///
+    ///@param base pointer to the first element of the whole array
+    ///@param dims dimensions of the whole array
+    ///@param offset index of the first element of the block
+    ///@param count dimensions of the block
+    ///@return H5MemoryView view of the block
+    ///
+    static H5MemoryView
+    block(T* base, const dims_array& dims, const dims_array& offset, const dims_array& count) {
+        Utils::runtime_assert(dims.size() == offset.size() && dims.size() == count.size(),
+                              "H5MemoryView block rank mismatch.");
+        auto   strides = row_major_strides(dims);
+        size_t first   = 0;
+        for (size_t i = 0; i < dims.size(); ++i) {
+            Utils::runtime_assert(offset[i] + count[i] <= dims[i],
+                                  "H5MemoryView block exceeds the array.");
+            first += offset[i] * strides[i];
+        }
+        return H5MemoryView(base + first, count, strides);
+    }
+
+    T*                data() const { return m_data; }
+    const dims_array& extents() const { return m_extents; }
+    const dims_array& strides() const { return m_strides; }
+    size_t            rank() const { return m_extents.size(); }
+
+    ///
+    ///@brief Returns the number of elements in the view.
+    ///
+    ///@return size_t product of the extents
+    ///
+    size_t element_count() const {
+        size_t n = 1;
+        for (auto e : m_extents) { n *= e; }
+        return n;
+    }
+
+    ///
+    ///@brief Checks if the elements of the view are contiguous in memory.
+    ///
+    ///@return true if the strides are the row-major strides of the extents
+    ///
+    bool is_contiguous() const { return m_strides == row_major_strides(m_extents); }
+
+    ///
+    ///@brief Returns a key identifying the memory dataspace of the view. Views with equal keys
+    ///       share the memory dataspace regardless of where their data is.
+    ///
+    ///@return dims_array the extents followed by the strides
+    ///
+    dims_array shape_key() const {
+        dims_array ret(m_extents);
+        ret.insert(ret.end(), m_strides.begin(), m_strides.end());
+        return ret;
+    }
+
+    ///
+    ///@brief Creates the memory dataspace of the view: the row-major allocation spanned by the
+    ///       strides with the elements of the view selected, relative to data().
+    ///
+    ///@return H5Dataspace the memory dataspace
+    ///
+    H5Dataspace create_dataspace() const {
+        if (is_contiguous() || element_count() == 0) { return H5Dataspace::create(m_extents); }
+
+        const size_t n = rank();
+        dims_array   allocation(n);
+        dims_array   step(n, 1);
+        if (n == 1) {
+            allocation[0] = (m_extents[0] - 1) * m_strides[0] + 1;
+        } else {
+            allocation[0]     = m_extents[0];
+            allocation[n - 1] = m_strides[n - 2];
+            for (size_t i = 1; i + 1 < n; ++i) { allocation[i] = m_strides[i - 1] / m_strides[i]; }
+        }
+        step[n - 1] = m_strides[n - 1];
+
+        return H5Hyperslab::select(
+            H5Dataspace::create(allocation), dims_array(n, 0), m_extents, step);
+    }
+
+private:
+    T*         m_data = nullptr;
+    dims_array m_extents;
+    dims_array m_strides;
+
+    static dims_array row_major_strides(const dims_array& extents) {
+        dims_array ret(extents.size(), 1);
+        for (size_t i = extents.size(); i-- > 1;) { ret[i - 1] = ret[i] * extents[i]; }
+        return ret;
+    }
+
+    static bool valid_strides(const dims_array& extents, const dims_array& strides) {
+        const size_t n = extents.size();
+        if (n == 0 || strides.size() != n) { return false; }
+        for (size_t i = 0; i < n; ++i) {
+            if (strides[i] == 0) { return false; }
+        }
+        // an empty view does not touch memory
+        for (size_t i = 0; i < n; ++i) {
+            if (extents[i] == 0) { return true; }
+        }
+        if (n == 1) { return true; }
+        // the last dimension may skip elements within a row of length strides[n - 2]
+        if ((extents[n - 1] - 1) * strides[n - 1] >= strides[n - 2]) { return false; }
+        for (size_t i = 1; i + 1 < n; ++i) {
+            if (strides[i - 1] % strides[i] != 0) { return false; }
+            if (extents[i] * strides[i] > strides[i - 1]) { return false; }
+        }
+        return true;
+    }
+};
+
+} // namespace H5Wrapper
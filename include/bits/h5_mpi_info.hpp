@@ -0,0 +1,123 @@
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+#include <mpi.h>
+#include <string>
+#include <utility> //std::pair
+#include <vector>
+
+#include "runtime_assert.hpp"
+
+namespace H5Wrapper {
+
+///
+///@brief Set of MPI-IO hints (e.g. "cb_nodes", "striping_factor", "romio_cb_write") passed to the
+///       MPI-IO file driver. Owns the underlying MPI_Info object, which is created on the first
+///       set() and freed when the last copy goes away. An empty hint set is MPI_INFO_NULL.
+///
+class H5MpiInfo {
+
+public:
+    H5MpiInfo() = default;
+
+    ///
+    ///@brief Construct from a list of key-value pairs, e.g. {{"cb_nodes", "4"}}.
+    ///
+    ///@param hints hints to set
+    ///
+    H5MpiInfo(std::initializer_list<std::pair<std::string, std::string>> hints) {
+        for (const auto& [key, value] : hints) { set(key, value); }
+    }
+
+    ///
+    ///@brief Takes the ownership of an existing MPI_Info object.
+    ///
+    ///@param info MPI_Info to be freed by this object, MPI_INFO_NULL results in an empty set
+    ///
+    static H5MpiInfo adopt(MPI_Info info) {
+        H5MpiInfo ret;
+        if (info != MPI_INFO_NULL) {
+            ret.m_info = std::shared_ptr<MPI_Info>(new MPI_Info(info), free_info);
+        }
+        return ret;
+    }
+
+    ///
+    ///@brief Sets the value of a hint. Copies share the MPI_Info object once it exists, so a copy
+    ///       made after the first set() sees the change, but a copy of an empty set does not.
+    ///
+    ///@param key hint name
+    ///@param value hint value
+    ///
+    void set(const std::string& key, const std::string& value) {
+        if (!m_info) {
+            MPI_Info info;
+            int      err = MPI_Info_create(&info);
+            Utils::runtime_assert(err == MPI_SUCCESS, "H5MpiInfo create fails.");
+            m_info = std::shared_ptr<MPI_Info>(new MPI_Info(info), free_info);
+        }
+        int err = MPI_Info_set(*m_info, key.c_str(), value.c_str());
+        Utils::runtime_assert(err == MPI_SUCCESS, "H5MpiInfo set fails.");
+    }
+
+    ///
+    ///@brief Returns the value of a hint.
+    ///
+    ///@param key hint name
+    ///@return std::string the value, empty if the hint is not set
+    ///
+    std::string get(const std::string& key) const {
+        if (!m_info) { return std::string(); }
+        int len, flag;
+        MPI_Info_get_valuelen(*m_info, key.c_str(), &len, &flag);
+        if (!flag) { return std::string(); }
+        std::vector<char> value(size_t(len) + 1);
+        MPI_Info_get(*m_info, key.c_str(), len, value.data(), &flag);
+        return std::string(value.data());
+    }
+
+    ///
+    ///@brief Returns the names of the hints set.
+    ///
+    ///@return std::vector<std::string> hint names
+    ///
+    std::vector<std::string> keys() const {
+        std::vector<std::string> ret;
+        if (!m_info) { return ret; }
+        int n;
+        MPI_Info_get_nkeys(*m_info, &n);
+        for (int i = 0; i < n; ++i) {
+            char key[MPI_MAX_INFO_KEY + 1];
+            MPI_Info_get_nthkey(*m_info, i, key);
+            ret.emplace_back(key);
+        }
+        return ret;
+    }
+
+    ///
+    ///@brief Checks if no hints have been set.
+    ///
+    ///@return true if the underlying object is MPI_INFO_NULL
+    ///
+    bool empty() const { return !m_info; }
+
+    ///
+    ///@brief Returns the underlying MPI_Info, MPI_INFO_NULL if no hints have been set.
+    ///
+    ///@return MPI_Info the info object
+    ///
+    MPI_Info operator~() const { return m_info ? *m_info : MPI_INFO_NULL; }
+
+private:
+    std::shared_ptr<MPI_Info> m_info;
+
+    static void free_info(MPI_Info* info) {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (!finalized && *info != MPI_INFO_NULL) { MPI_Info_free(info); }
+        delete info;
+    }
+};
+
+} // namespace H5Wrapper
@@ -3,13 +3,30 @@
 #include <hdf5.h>
 #include <iostream>
 
+#include "h5_library_lock.hpp"
 #include "runtime_assert.hpp"
 
 namespace H5Wrapper {
 
+///
+///@brief Reference counted handle to an HDF5 identifier. Every subclass passes the HDF5 close
+///       function of its identifier kind (H5Sclose, H5Dclose, ...) on construction, so closing a
+///       handle is a single direct call. Copies increment the reference count of the identifier,
+///       and a handle whose identifier is zero (default constructed, moved from or closed) owns
+///       nothing. The lifecycle never queries the HDF5 identifier table.
+///
+///       A handle constructed with the Borrowed tag is a view of an identifier owned elsewhere,
+///       e.g. by an H5UniqueHandle. Views and their copies neither touch the reference count
+///       nor close the identifier, and must not outlive the owner.
+///
 class H5Object {
 
 public:
+    ///
+    ///@brief Function closing an identifier, e.g. H5Sclose.
+    ///
+    using closer_type = herr_t (*)(hid_t);
+
     enum class Type {
         UNINITIALIZED,
         BADOBJECT,
@@ -30,25 +47,29 @@ public:
 
     enum class Policy { WITH_WARD = 1, WITHOUT_WARD = 2 };
 
+    ///
+    ///@brief Tag selecting the constructors which make a non-owning view of an identifier.
+    ///
+    struct Borrowed {};
+    static constexpr Borrowed borrowed{};
+
     ///
     ///@brief Default construct. Results in an invalid state.
     ///
     ///
     explicit H5Object()
-        : m_handle(0) {}
+        : m_handle(0)
+        , m_closer(&close_any) {}
 
     ///
-    ///@brief Construct from id and policy
+    ///@brief Construct from id and policy. The kind of the identifier is looked up when it is
+    ///       closed. Subclasses know the kind and use the constructor taking a closer instead.
     ///
     ///@param id
     ///@param policy
     ///
     explicit H5Object(hid_t id, Policy policy = Policy::WITH_WARD)
-        : m_handle(id) {
-        Utils::runtime_assert(m_handle >= 0, "H5Object costructor fails. Invalid hid.");
-
-        if (policy == Policy::WITHOUT_WARD) { increment_reference_count(); }
-    }
+        : H5Object(id, &close_any, policy) {}
 
     ///
     ///@brief Copy construct
@@ -56,9 +77,10 @@ public:
     ///@param other a copyable handle
     ///
     H5Object(const H5Object& other)
-        : m_handle(other.m_handle) {
+        : m_handle(other.m_handle)
+        , m_closer(other.m_closer) {
 
-        if (is_valid()) { increment_reference_count(); }
+        if (owns_handle()) { increment_reference_count(); }
     }
 
     ///
@@ -67,7 +89,8 @@ public:
     ///@param other a movable handle
     ///
     H5Object(H5Object&& other) noexcept
-        : m_handle(other.m_handle) {
+        : m_handle(other.m_handle)
+        , m_closer(other.m_closer) {
         other.m_handle = 0;
     }
 
@@ -80,11 +103,12 @@ public:
     H5Object& operator=(const H5Object& other) {
         if (this == &other) { return *this; }
 
-        if (is_valid()) { close(); }
+        if (owns_handle()) { close_unchecked(); }
 
-        if (other.is_valid()) { other.increment_reference_count(); }
+        if (other.owns_handle()) { other.increment_reference_count(); }
 
         m_handle = other.m_handle;
+        m_closer = other.m_closer;
 
         return *this;
     }
@@ -98,9 +122,10 @@ public:
     H5Object& operator=(H5Object&& other) noexcept {
         if (this == &other) { return *this; }
 
-        if (is_valid()) { close(); }
+        if (owns_handle()) { close_unchecked(); }
 
         m_handle       = other.m_handle;
+        m_closer       = other.m_closer;
         other.m_handle = 0;
 
         return *this;
@@ -111,7 +136,7 @@ public:
     ///
     ///
     ~H5Object() {
-        if (is_valid()) { close(); }
+        if (owns_handle()) { close_unchecked(); }
     }
 
     ///
@@ -128,34 +153,14 @@ public:
     hid_t operator~() { return m_handle; }
 
     ///
-    ///@brief Safely close the handle
+    ///@brief Closes the handle, i.e. decrements the reference count of the identifier, and
+    ///       resets it to zero. A view is only reset. Unlike the destructor and the assignments,
+    ///       which ignore it, a failure to close is reported.
     ///
     ///
     void close() {
-
-        H5Object::Type oht{Type::UNINITIALIZED};
-
-        oht = get_type();
-
-        herr_t error_code = 0;
-        switch (oht) {
-        case H5Object::Type::DATASPACE: error_code = H5Sclose(m_handle); break;
-        case H5Object::Type::GROUP: error_code = H5Gclose(m_handle); break;
-        case H5Object::Type::DATATYPE: error_code = H5Tclose(m_handle); break;
-        case H5Object::Type::ATTRIBUTE: error_code = H5Aclose(m_handle); break;
-        case H5Object::Type::FILE: error_code = H5Fclose(m_handle); break;
-        case H5Object::Type::PROPERTY_LIST: error_code = H5Pclose(m_handle); break;
-        case H5Object::Type::PROPERTY_LIST_CLASS: error_code = H5Pclose_class(m_handle); break;
-        case H5Object::Type::ERROR_MESSAGE: error_code = H5Eclose_msg(m_handle); break;
-        case H5Object::Type::ERROR_STACK: error_code = H5Eclose_stack(m_handle); break;
-        case H5Object::Type::ERROR_CLASS: error_code = H5Eunregister_class(m_handle); break;
-        default: error_code = H5Oclose(m_handle);
-        }
-
+        herr_t error_code = close_unchecked();
         Utils::runtime_assert(error_code >= 0, "Could not close hid");
-
-        // in any case we have to reset the ID of the obejct
-        m_handle = 0;
     }
 
     ///
@@ -166,7 +171,8 @@ public:
     ///
     bool is_valid() const {
 
-        if (m_handle == 0) { return false; }
+        if (m_handle <= 0) { return false; }
+        auto   lock  = detail::library_lock();
         htri_t value = H5Iis_valid(m_handle);
 
         Utils::runtime_assert(value >= 0, "Could not determine validity of handle.");
@@ -179,8 +185,17 @@ public:
     ///
     ///@return H5Object::Type type
     ///
-    H5Object::Type get_type() const {
-        H5I_type_t type = H5Iget_type(m_handle);
+    H5Object::Type get_type() const { return type_of(m_handle); }
+
+    ///
+    ///@brief Get the type of an identifier
+    ///
+    ///@param id identifier to query
+    ///@return H5Object::Type type
+    ///
+    static H5Object::Type type_of(hid_t id) {
+        auto       lock = detail::library_lock();
+        H5I_type_t type = H5Iget_type(id);
 
         switch (type) {
         case H5I_UNINIT: return H5Object::Type::UNINITIALIZED;
@@ -203,27 +218,123 @@ public:
         return {};
     }
 
+    ///
+    ///@brief Checks if the handle is a non-owning view.
+    ///
+    ///@return true if constructed with the Borrowed tag
+    ///
+    bool is_borrowed() const noexcept { return m_closer == nullptr; }
+
+    ///
+    ///@brief Gives up the ownership of one reference to the identifier without closing it. The
+    ///       handle is reset to zero. Releasing a view acquires a new reference for the caller.
+    ///
+    ///@return hid_t identifier the caller now has to close
+    ///
+    hid_t release() {
+        if (is_borrowed() && m_handle > 0) { increment_reference_count(); }
+        hid_t id = m_handle;
+        m_handle = 0;
+        return id;
+    }
+
     ///
     ///@brief Get the number of references to the handle
     ///
     ///@return int number of references
     ///
     int get_reference_count() const {
-        int ref_cnt = H5Iget_ref(m_handle);
+        auto lock    = detail::library_lock();
+        int  ref_cnt = H5Iget_ref(m_handle);
         Utils::runtime_assert(ref_cnt >= 0, "H5Object: could not get reference counter");
 
         return ref_cnt;
     }
 
+protected:
+    ///
+    ///@brief Construct from an id and the function closing it.
+    ///
+    ///@param id identifier to own
+    ///@param closer close function of the identifier kind, e.g. H5Sclose
+    ///@param policy WITHOUT_WARD increments the reference count of an id owned elsewhere
+    ///
+    H5Object(hid_t id, closer_type closer, Policy policy = Policy::WITH_WARD)
+        : m_handle(id)
+        , m_closer(closer) {
+        Utils::runtime_assert(m_handle >= 0, "H5Object costructor fails. Invalid hid.");
+
+        if (policy == Policy::WITHOUT_WARD) { increment_reference_count(); }
+    }
+
+    ///
+    ///@brief Construct a non-owning view of an id.
+    ///
+    ///@param id identifier owned elsewhere
+    ///
+    H5Object(hid_t id, Borrowed) noexcept
+        : m_handle(id)
+        , m_closer(nullptr) {}
+
+    ///
+    ///@brief Checks if the handle holds an identifier it has to close. Unlike is_valid(), does
+    ///       not consult HDF5.
+    ///
+    ///@return true if the identifier is nonzero and not borrowed
+    ///
+    bool owns_handle() const noexcept { return m_handle > 0 && m_closer != nullptr; }
+
 private:
-    hid_t m_handle;
+    hid_t       m_handle;
+    closer_type m_closer;
+
+    ///
+    ///@brief Closes the handle without checking the result, for the destructor and the
+    ///       assignments, which must not throw.
+    ///
+    ///@return herr_t negative if the identifier could not be closed
+    ///
+    herr_t close_unchecked() noexcept {
+        herr_t error_code = 0;
+        if (m_closer != nullptr) {
+            auto lock  = detail::library_lock();
+            error_code = m_closer(m_handle);
+        }
+
+        // in any case we have to reset the ID of the obejct
+        m_handle = 0;
+        return error_code;
+    }
+
+    ///
+    ///@brief Closes an identifier of any kind by looking up its type.
+    ///
+    ///@param id identifier to close
+    ///@return herr_t negative on failure
+    ///
+    static herr_t close_any(hid_t id) {
+        switch (type_of(id)) {
+        case H5Object::Type::DATASPACE: return H5Sclose(id);
+        case H5Object::Type::GROUP: return H5Gclose(id);
+        case H5Object::Type::DATATYPE: return H5Tclose(id);
+        case H5Object::Type::ATTRIBUTE: return H5Aclose(id);
+        case H5Object::Type::FILE: return H5Fclose(id);
+        case H5Object::Type::PROPERTY_LIST: return H5Pclose(id);
+        case H5Object::Type::PROPERTY_LIST_CLASS: return H5Pclose_class(id);
+        case H5Object::Type::ERROR_MESSAGE: return H5Eclose_msg(id);
+        case H5Object::Type::ERROR_STACK: return H5Eclose_stack(id);
+        case H5Object::Type::ERROR_CLASS: return H5Eunregister_class(id);
+        default: return H5Oclose(id);
+        }
+    }
 
     ///
     ///@brief Safely increment the reference count
     ///
     ///
     void increment_reference_count() const {
-        auto err = H5Iinc_ref(m_handle);
+        auto lock = detail::library_lock();
+        auto err  = H5Iinc_ref(m_handle);
         Utils::runtime_assert(err >= 0, "H5Object reference count increment fails.");
     }
 
@@ -232,6 +343,7 @@ private:
     ///
     ///
     void decrement_reference_count() const {
+        auto lock = detail::library_lock();
 
         auto err = H5Idec_ref(m_handle);
         Utils::runtime_assert(err >= 0, "H5Object reference count decrement fails.");
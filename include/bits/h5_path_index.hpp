@@ -0,0 +1,224 @@
+#pragma once
+
+#include <hdf5.h>
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "h5_library_lock.hpp"
+
+namespace H5Wrapper {
+
+namespace detail {
+
+///
+///@brief Calls op(component) for every non-empty component of a '/' separated path. Repeated
+///       separators and "." components are skipped. Reentrant and without a length limit.
+///
+///@param path the path to split
+///@param op callable taking (std::string_view component)
+///
+template <class Op> void for_each_path_component(std::string_view path, Op&& op) {
+    size_t begin = 0;
+    while (begin < path.size()) {
+        size_t end = path.find('/', begin);
+        if (end == std::string_view::npos) { end = path.size(); }
+        auto component = path.substr(begin, end - begin);
+        if (!component.empty() && component != ".") { op(component); }
+        begin = end + 1;
+    }
+}
+
+///
+///@brief Joins a relative path to an absolute base path and normalizes the result to the form
+///       "/a/b/c". An absolute path replaces the base.
+///
+///@param base absolute path of the location
+///@param path absolute or relative path
+///@return std::string normalized absolute path
+///
+static inline std::string join_path(std::string_view base, std::string_view path) {
+    std::string ret;
+    ret.reserve(base.size() + path.size() + 1);
+    auto append = [&ret](std::string_view component) {
+        ret += '/';
+        ret += component;
+    };
+    if (path.empty() || path[0] != '/') { for_each_path_component(base, append); }
+    for_each_path_component(path, append);
+    if (ret.empty()) { ret = "/"; }
+    return ret;
+}
+
+} // namespace detail
+
+///
+///@brief Per-file cache of absolute paths known to exist, mapped to the type of the object. The
+///       index is filled by the group and dataset create/open calls of the wrapper and by
+///       successful existence queries, and is consulted by H5Group::exists before touching the
+///       file. Only positive results are cached, so objects created outside of the wrapper are
+///       still found. Groups opened with the default access properties are kept open by the
+///       index and shared by later opens of the same path. H5Location::remove_link erases the
+///       removed path, links deleted or moved outside of the wrapper must be reported with
+///       erase() or clear(). Safe to share between threads.
+///
+class H5PathIndex {
+
+public:
+    H5PathIndex() = default;
+
+    H5PathIndex(const H5PathIndex&) = delete;
+    H5PathIndex& operator=(const H5PathIndex&) = delete;
+
+    ~H5PathIndex() { close_groups(); }
+
+    ///
+    ///@brief Adds an absolute path to the index.
+    ///
+    ///@param path normalized absolute path
+    ///@param type object type, H5O_TYPE_UNKNOWN if not known
+    ///
+    void insert(const std::string& path, H5O_type_t type = H5O_TYPE_UNKNOWN) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [it, inserted] = m_paths.emplace(path, Entry{type});
+        if (!inserted && type != H5O_TYPE_UNKNOWN) { it->second.type = type; }
+    }
+
+    ///
+    ///@brief Adds an absolute path and all its parents, which have to be groups, to the index.
+    ///
+    ///@param path normalized absolute path
+    ///@param type object type of the last component
+    ///
+    void insert_with_parents(const std::string& path, H5O_type_t type = H5O_TYPE_UNKNOWN) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t pos = path.find('/', 1); pos != std::string::npos;
+             pos        = path.find('/', pos + 1)) {
+            m_paths.emplace(path.substr(0, pos), Entry{H5O_TYPE_GROUP});
+        }
+        auto [it, inserted] = m_paths.emplace(path, Entry{type});
+        if (!inserted && type != H5O_TYPE_UNKNOWN) { it->second.type = type; }
+    }
+
+    ///
+    ///@brief Checks if a path is known to exist.
+    ///
+    ///@param path normalized absolute path
+    ///@return true if the path is in the index
+    ///@return false if the path is not known, it may still exist in the file
+    ///
+    bool contains(const std::string& path) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_paths.count(path) > 0;
+    }
+
+    ///
+    ///@brief Returns the cached object type of a path.
+    ///
+    ///@param path normalized absolute path
+    ///@return H5O_type_t type of the object, H5O_TYPE_UNKNOWN if the path or its type is unknown
+    ///
+    H5O_type_t type(const std::string& path) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_paths.find(path);
+        return it == m_paths.end() ? H5O_TYPE_UNKNOWN : it->second.type;
+    }
+
+    ///
+    ///@brief Keeps an open group for later opens of its path, which has to be in the index. The
+    ///       index holds a reference to the identifier until the path is erased or the groups
+    ///       are closed.
+    ///
+    ///@param path normalized absolute path of the group
+    ///@param group identifier of the open group
+    ///
+    void cache_group(const std::string& path, hid_t group) {
+        auto                        library = detail::library_lock();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_paths.find(path);
+        if (it == m_paths.end() || it->second.group > 0) { return; }
+        if (H5Iinc_ref(group) >= 0) { it->second.group = group; }
+    }
+
+    ///
+    ///@brief Returns the open group cached for a path.
+    ///
+    ///@param path normalized absolute path
+    ///@return hid_t identifier owned by the index, H5I_INVALID_HID if no group is cached
+    ///
+    hid_t cached_group(const std::string& path) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_paths.find(path);
+        return it == m_paths.end() || it->second.group <= 0 ? H5I_INVALID_HID : it->second.group;
+    }
+
+    ///
+    ///@brief Closes the cached groups and keeps the paths, e.g. when the file is closed.
+    ///
+    ///
+    void close_groups() {
+        auto                        library = detail::library_lock();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [path, entry] : m_paths) { close_group(entry); }
+    }
+
+    ///
+    ///@brief Removes a path and everything below it from the index and closes their cached
+    ///       groups.
+    ///
+    ///@param path normalized absolute path
+    ///
+    void erase(const std::string& path) {
+        auto                        library = detail::library_lock();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::string           prefix = path + '/';
+        for (auto it = m_paths.begin(); it != m_paths.end();) {
+            if (it->first == path || it->first.compare(0, prefix.size(), prefix) == 0) {
+                close_group(it->second);
+                it = m_paths.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    ///
+    ///@brief Removes all paths from the index and closes the cached groups.
+    ///
+    ///
+    void clear() {
+        auto                        library = detail::library_lock();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [path, entry] : m_paths) { close_group(entry); }
+        m_paths.clear();
+    }
+
+    ///
+    ///@brief Returns the number of paths in the index.
+    ///
+    ///@return size_t number of paths
+    ///
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_paths.size();
+    }
+
+private:
+    struct Entry {
+        H5O_type_t type;
+        hid_t      group = H5I_INVALID_HID; // open group held by the index, if cached
+    };
+
+    mutable std::mutex                     m_mutex;
+    std::unordered_map<std::string, Entry> m_paths;
+
+    // the caller holds the library lock, the result is ignored as this runs in destructors
+    static void close_group(Entry& entry) noexcept {
+        if (entry.group > 0) { H5Idec_ref(entry.group); }
+        entry.group = H5I_INVALID_HID;
+    }
+};
+
+} // namespace H5Wrapper
@@ -1,8 +1,16 @@
 #pragma once
 
+#include <algorithm> //std::min, std::max
+#include <cmath>     //std::log10, std::pow
 #include <hdf5.h>
 #include <mpi.h>
+#include <stdexcept> //std::runtime_error
+#include <string>
+#include <utility> //std::pair
+#include <vector>
 
+#include "h5_dataspace.hpp"
+#include "h5_mpi_info.hpp"
 #include "h5_object.hpp"
 #include "runtime_assert.hpp"
 
@@ -70,118 +78,1416 @@ static inline hid_t to_h5_handle(PropertyType type) {
 }
 
 
-static inline PropertyType to_type(hid_t handle) {
+///
+///@brief Returns the library default property list of a property type, H5P_DEFAULT for the
+///       abstract types which have none.
+///
+///@param type property type
+///@return hid_t default property list identifier
+///
+static inline hid_t to_h5_default(PropertyType type) {
+    switch (type) {
+    case PropertyType::ATTRIBUTE_CREATE: return H5P_ATTRIBUTE_CREATE_DEFAULT;
+    case PropertyType::DATASET_ACCESS: return H5P_DATASET_ACCESS_DEFAULT;
+    case PropertyType::DATASET_CREATE: return H5P_DATASET_CREATE_DEFAULT;
+    case PropertyType::DATASET_XFER: return H5P_DATASET_XFER_DEFAULT;
+    case PropertyType::DATATYPE_ACCESS: return H5P_DATATYPE_ACCESS_DEFAULT;
+    case PropertyType::DATATYPE_CREATE: return H5P_DATATYPE_CREATE_DEFAULT;
+    case PropertyType::FILE_ACCESS: return H5P_FILE_ACCESS_DEFAULT;
+    case PropertyType::FILE_CREATE: return H5P_FILE_CREATE_DEFAULT;
+    case PropertyType::FILE_MOUNT: return H5P_FILE_MOUNT_DEFAULT;
+    case PropertyType::GROUP_ACCESS: return H5P_GROUP_ACCESS_DEFAULT;
+    case PropertyType::GROUP_CREATE: return H5P_GROUP_CREATE_DEFAULT;
+    case PropertyType::LINK_ACCESS: return H5P_LINK_ACCESS_DEFAULT;
+    case PropertyType::LINK_CREATE: return H5P_LINK_CREATE_DEFAULT;
+    case PropertyType::OBJECT_COPY: return H5P_OBJECT_COPY_DEFAULT;
+    default: return H5P_DEFAULT;
+    }
+}
 
-    if (bool(H5Pequal(handle, H5P_ATTRIBUTE_CREATE))) { return PropertyType::ATTRIBUTE_CREATE; }
 
-    if (bool(H5Pequal(handle, H5P_DATASET_ACCESS))) { return PropertyType::DATASET_ACCESS; }
+///
+///@brief Sets the number of attributes at which an object header switches from compact to dense
+///       attribute storage (max_compact) and back (min_dense). Dense storage keeps the attributes
+///       in a fractal heap indexed by a B-tree, which is faster for objects with many attributes.
+///
+///@param ocpl object (group or dataset) creation property list
+///@param max_compact maximum number of attributes stored compactly
+///@param min_dense minimum number of attributes stored densely
+///
+static inline void set_attribute_phase_change(hid_t    ocpl,
+                                              unsigned max_compact,
+                                              unsigned min_dense) {
+    auto   lock = detail::library_lock();
+    herr_t err  = H5Pset_attr_phase_change(ocpl, max_compact, min_dense);
+    Utils::runtime_assert(err >= 0, "Set attribute phase change fails.");
+}
 
-    if (bool(H5Pequal(handle, H5P_DATASET_CREATE))) { return PropertyType::DATASET_CREATE; }
+static inline std::pair<unsigned, unsigned> get_attribute_phase_change(hid_t ocpl) {
+    auto     lock = detail::library_lock();
+    unsigned max_compact, min_dense;
+    herr_t   err = H5Pget_attr_phase_change(ocpl, &max_compact, &min_dense);
+    Utils::runtime_assert(err >= 0, "Get attribute phase change fails.");
+    return {max_compact, min_dense};
+}
 
-    if (bool(H5Pequal(handle, H5P_DATASET_XFER))) { return PropertyType::DATASET_XFER; }
+///
+///@brief Stores a flag of the wrapper in a property list as a property of its own, so that it
+///       is copied along with the list by H5Pcopy and seen by every handle of the list.
+///
+///@param plist property list
+///@param name property name, prefixed with "H5Wrapper."
+///@param value flag value
+///
+static inline void set_flag(hid_t plist, const char* name, bool value) {
+    auto   lock = detail::library_lock();
+    herr_t err  = H5Pexist(plist, name) > 0
+                      ? H5Pset(plist, name, &value)
+                      : H5Pinsert2(plist, name, sizeof(value), &value, NULL, NULL, NULL, NULL,
+                                   NULL, NULL);
+    Utils::runtime_assert(err >= 0, "Set property flag fails.");
+}
 
-    if (bool(H5Pequal(handle, H5P_DATATYPE_ACCESS))) { return PropertyType::DATATYPE_ACCESS; }
+///
+///@brief Returns a flag stored with set_flag.
+///
+///@param plist property list
+///@param name property name
+///@return the flag, false if it has never been set
+///
+static inline bool get_flag(hid_t plist, const char* name) {
+    auto lock  = detail::library_lock();
+    bool value = false;
+    if (H5Pexist(plist, name) > 0) {
+        herr_t err = H5Pget(plist, name, &value);
+        Utils::runtime_assert(err >= 0, "Get property flag fails.");
+    }
+    return value;
+}
 
-    if (bool(H5Pequal(handle, H5P_DATATYPE_CREATE))) { return PropertyType::DATATYPE_CREATE; }
+template <PropertyType T> struct H5Property : public H5Object {
 
-    if (bool(H5Pequal(handle, H5P_FILE_ACCESS))) { return PropertyType::FILE_ACCESS; }
+    static constexpr PropertyType property_type = T;
 
-    if (bool(H5Pequal(handle, H5P_FILE_CREATE))) { return PropertyType::FILE_CREATE; }
+    H5Property()
+        : H5Object(create(), &H5Pclose) {}
 
-    if (bool(H5Pequal(handle, H5P_FILE_MOUNT))) { return PropertyType::FILE_MOUNT; }
+    explicit H5Property(hid_t id)
+        : H5Object(id, &H5Pclose) {
+        auto lock = detail::library_lock();
+        // a single class membership test
+        Utils::runtime_assert(H5Pisa_class(id, detail::to_h5_handle(T)) > 0,
+                              "Invalid property type handle.");
+    }
 
-    if (bool(H5Pequal(handle, H5P_GROUP_ACCESS))) { return PropertyType::GROUP_ACCESS; }
+    ///
+    ///@brief Construct a non-owning view of a property list owned elsewhere.
+    ///
+    ///@param id property list identifier
+    ///
+    H5Property(hid_t id, H5Object::Borrowed tag)
+        : H5Object(id, tag) {}
+
+protected:
+    ///
+    ///@brief Returns the identifier to be modified by a setter. A view does not own its list,
+    ///       which may be a library default or shared by the whole process, so views and their
+    ///       copies are read-only and setters called on them fail.
+    ///
+    ///@return hid_t the identifier, invalid for a view
+    ///
+    hid_t writable_handle() const {
+        Utils::runtime_assert(!this->is_borrowed(), "Property list view is read-only.");
+        return this->is_borrowed() ? H5I_INVALID_HID : this->get_handle();
+    }
 
-    if (bool(H5Pequal(handle, H5P_GROUP_CREATE))) { return PropertyType::GROUP_CREATE; }
+private:
+    static hid_t create() {
+        auto lock = detail::library_lock();
+        return H5Pcreate(detail::to_h5_handle(T));
+    }
+};
 
-    if (bool(H5Pequal(handle, H5P_LINK_ACCESS))) { return PropertyType::LINK_ACCESS; }
+} // namespace detail
 
-    if (bool(H5Pequal(handle, H5P_LINK_CREATE))) { return PropertyType::LINK_CREATE; }
+struct H5AttributeCreateProperty : public detail::H5Property<PropertyType::ATTRIBUTE_CREATE> {
+    using detail::H5Property<PropertyType::ATTRIBUTE_CREATE>::H5Property;
+};
 
-    if (bool(H5Pequal(handle, H5P_OBJECT_COPY))) { return PropertyType::OBJECT_COPY; }
+///
+///@brief Shape of the selections a chunked dataset is read or written with, declared when the
+///       dataset is opened so that the chunk cache can hold every chunk one selection touches.
+///       The chunks are then read once per sweep instead of once per selection.
+///
+class H5AccessPattern {
+
+public:
+    ///
+    ///@brief Selections of whole planes (or slabs of several planes) advancing along an axis,
+    ///       e.g. reading a 3-d field plane by plane along axis 2.
+    ///
+    ///@param axis the axis the planes advance along
+    ///@param thickness number of consecutive indices along the axis in a selection
+    ///@return H5AccessPattern the pattern
+    ///
+    static H5AccessPattern planes(size_t axis, size_t thickness = 1) {
+        H5AccessPattern ret;
+        ret.m_axis      = axis;
+        ret.m_thickness = thickness;
+        return ret;
+    }
 
-    if (bool(H5Pequal(handle, H5P_OBJECT_CREATE))) { return PropertyType::OBJECT_CREATE; }
+    ///
+    ///@brief Selections of a fixed shape at arbitrary offsets.
+    ///
+    ///@param count dimensions of a selection
+    ///@return H5AccessPattern the pattern
+    ///
+    static H5AccessPattern blocks(const std::vector<size_t>& count) {
+        H5AccessPattern ret;
+        ret.m_count = count;
+        return ret;
+    }
 
-    if (bool(H5Pequal(handle, H5P_STRING_CREATE))) { return PropertyType::STRING_CREATE; }
+    bool is_planes() const { return m_count.empty(); }
+
+    ///
+    ///@brief Returns the dimensions of a selection in a dataset.
+    ///
+    ///@param dims dimensions of the dataset
+    ///@return std::vector<size_t> dimensions of a selection
+    ///
+    std::vector<size_t> selection(const std::vector<size_t>& dims) const {
+        if (!is_planes()) {
+            Utils::runtime_assert(m_count.size() == dims.size(), "H5AccessPattern rank mismatch.");
+            return m_count;
+        }
+        Utils::runtime_assert(m_axis < dims.size(), "H5AccessPattern axis out of range.");
+        std::vector<size_t> ret(dims);
+        ret[m_axis] = std::min(m_thickness, dims[m_axis]);
+        return ret;
+    }
 
-    throw std::runtime_error("Not a Property type handle");
-}
+    ///
+    ///@brief Returns the largest number of chunks a selection touches. Planes start at multiples
+    ///       of their thickness, blocks may start anywhere.
+    ///
+    ///@param dims dimensions of the dataset
+    ///@param chunk dimensions of a chunk
+    ///@return size_t number of chunks
+    ///
+    size_t chunks_per_selection(const std::vector<size_t>& dims,
+                                const std::vector<size_t>& chunk) const {
+        Utils::runtime_assert(dims.size() == chunk.size(), "H5AccessPattern rank mismatch.");
+        const auto count = selection(dims);
+        size_t     ret   = 1;
+        for (size_t i = 0; i < dims.size(); ++i) {
+            const size_t total = (dims[i] + chunk[i] - 1) / chunk[i];
+            size_t       n     = 0;
+            if (count[i] == dims[i]) {
+                n = total;
+            } else if (is_planes() && chunk[i] % count[i] == 0) {
+                n = 1; // aligned planes stay within a chunk
+            } else {
+                n = (count[i] + chunk[i] - 2) / chunk[i] + 1; // worst case offset
+            }
+            ret *= std::min(std::max(n, size_t(1)), total);
+        }
+        return ret;
+    }
 
+private:
+    size_t              m_axis      = 0;
+    size_t              m_thickness = 1;
+    std::vector<size_t> m_count; // empty for planes
+};
 
-template <PropertyType T> struct H5Property : public H5Object {
+struct H5DatasetAccessProperty : public detail::H5Property<PropertyType::DATASET_ACCESS> {
+    using detail::H5Property<PropertyType::DATASET_ACCESS>::H5Property;
+
+    ///
+    ///@brief Configures the chunk cache of the dataset. HDF5 caches 1 MiB of chunks in 521 hash
+    ///       slots per dataset by default, which a selection touching more chunks than fit
+    ///       thrashes: every chunk is read and decompressed again for every selection.
+    ///
+    ///@param slots number of hash table slots, ideally a prime about 100 times the number of
+    /// chunks which fit into the cache
+    ///@param bytes size of the cache in bytes
+    ///@param preemption between 0 and 1, how strongly chunks which have been read or written
+    /// completely are preferred for eviction
+    ///
+    void set_chunk_cache(size_t slots, size_t bytes, double preemption = 0.75) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_chunk_cache(this->writable_handle(), slots, bytes, preemption);
+        Utils::runtime_assert(err >= 0, "H5DatasetAccessProperty set_chunk_cache fails.");
+    }
 
-    // static constexpr my_type = T;
+    ///
+    ///@brief Sizes the chunk cache to hold every chunk touched by a selection of an access
+    ///       pattern, so that each chunk is read once per sweep. Chunks which have been read
+    ///       completely are evicted first.
+    ///
+    ///@param dims dimensions of the dataset
+    ///@param chunk dimensions of a chunk
+    ///@param element_size size of an element in the file in bytes
+    ///@param pattern the access pattern
+    ///
+    void fit_chunk_cache(const std::vector<size_t>& dims,
+                         const std::vector<size_t>& chunk,
+                         size_t                     element_size,
+                         const H5AccessPattern&     pattern) {
+        size_t chunk_bytes = element_size;
+        for (auto c : chunk) { chunk_bytes *= c; }
+        const size_t n = pattern.chunks_per_selection(dims, chunk);
+        // about 100 slots per chunk, as recommended for set_chunk_cache, keep hash collisions
+        // rare; a slot costs only a pointer
+        set_chunk_cache(next_prime(std::max(size_t(521), 100 * n)), n * chunk_bytes, 1.0);
+    }
 
-    H5Property()
-        : H5Object(H5Pcreate(detail::to_h5_handle(T))) {}
+    size_t get_chunk_cache_slots() const { return get_chunk_cache().slots; }
+    size_t get_chunk_cache_bytes() const { return get_chunk_cache().bytes; }
+    double get_chunk_cache_preemption() const { return get_chunk_cache().preemption; }
+
+private:
+    struct ChunkCache {
+        size_t slots;
+        size_t bytes;
+        double preemption;
+    };
+
+    ChunkCache get_chunk_cache() const {
+        auto       lock = detail::library_lock();
+        ChunkCache ret;
+        herr_t     err =
+            H5Pget_chunk_cache(this->get_handle(), &ret.slots, &ret.bytes, &ret.preemption);
+        Utils::runtime_assert(err >= 0, "H5DatasetAccessProperty get_chunk_cache fails.");
+        return ret;
+    }
 
-    explicit H5Property(hid_t id)
-        : H5Object(id) {
-        Utils::runtime_assert(detail::to_type(id) == T, "Invalid property type handle.");
+    static size_t next_prime(size_t n) {
+        auto is_prime = [](size_t p) {
+            if (p < 2) { return false; }
+            for (size_t d = 2; d * d <= p; ++d) {
+                if (p % d == 0) { return false; }
+            }
+            return true;
+        };
+        while (!is_prime(n)) { ++n; }
+        return n;
     }
 };
 
-} // namespace detail
+struct H5DatasetCreateProperty : public detail::H5Property<PropertyType::DATASET_CREATE> {
 
-struct H5AttributeCreateProperty : public detail::H5Property<PropertyType::ATTRIBUTE_CREATE> {};
+    H5DatasetCreateProperty() = default;
 
-struct H5DatasetAccessProperty : public detail::H5Property<PropertyType::DATASET_ACCESS> {};
+    explicit H5DatasetCreateProperty(hid_t id)
+        : detail::H5Property<PropertyType::DATASET_CREATE>(id) {}
 
-struct H5DatasetCreateProperty : public detail::H5Property<PropertyType::DATASET_CREATE> {};
+    H5DatasetCreateProperty(hid_t id, H5Object::Borrowed tag)
+        : detail::H5Property<PropertyType::DATASET_CREATE>(id, tag) {}
+
+    ///
+    ///@brief Sets when the attributes of the dataset switch between compact and dense storage.
+    ///
+    ///@param max_compact maximum number of attributes stored in the object header, 8 by default
+    ///@param min_dense minimum number of attributes stored densely, 6 by default
+    ///
+    void set_attribute_phase_change(unsigned max_compact, unsigned min_dense) {
+        detail::set_attribute_phase_change(this->writable_handle(), max_compact, min_dense);
+    }
+
+    ///
+    ///@brief Stores all attributes of the dataset densely, for objects with many attributes.
+    ///
+    ///
+    void set_dense_attributes() { set_attribute_phase_change(0, 0); }
+
+    ///
+    ///@brief Returns the attribute storage thresholds.
+    ///
+    ///@return std::pair<unsigned, unsigned> max_compact and min_dense
+    ///
+    std::pair<unsigned, unsigned> get_attribute_phase_change() const {
+        return detail::get_attribute_phase_change(this->get_handle());
+    }
+
+    ///
+    ///@brief Sets the layout to chunked and the size of the chunks used to store the dataset.
+    ///
+    ///@param chunk_dims Chunk dimensions, the rank has to match the rank of the dataset.
+    ///
+    void set_chunk(const std::vector<size_t>& chunk_dims) {
+        auto                 lock = detail::library_lock();
+        std::vector<hsize_t> dims(chunk_dims.begin(), chunk_dims.end());
+        herr_t err = H5Pset_chunk(this->writable_handle(), int(dims.size()), dims.data());
+        Utils::runtime_assert(err >= 0, "H5DatasetCreateProperty set_chunk fails.");
+    }
+
+    ///
+    ///@brief Sets a chunked layout with the chunk shape given by guess_chunk().
+    ///
+    ///@param dataspace Dataspace of the dataset to be created.
+    ///@param element_size Size of a dataset element in bytes.
+    ///
+    void set_auto_chunk(const H5Dataspace& dataspace, size_t element_size) {
+        set_chunk(guess_chunk(dataspace.get_dimensions(), element_size));
+    }
+
+    ///
+    ///@brief Retrieves the size of the chunks.
+    ///
+    ///@return std::vector<size_t> Chunk dimensions, empty if the layout is not chunked.
+    ///
+    std::vector<size_t> get_chunk() const {
+        auto lock = detail::library_lock();
+        if (get_layout() != H5D_CHUNKED) { return {}; }
+        std::vector<hsize_t> dims(H5S_MAX_RANK);
+        int rank = H5Pget_chunk(this->get_handle(), int(dims.size()), dims.data());
+        Utils::runtime_assert(rank >= 0, "H5DatasetCreateProperty get_chunk fails.");
+        return std::vector<size_t>(dims.begin(), dims.begin() + rank);
+    }
+
+    ///
+    ///@brief Returns the layout of the raw data for a dataset.
+    ///
+    ///@return H5D_layout_t H5D_COMPACT, H5D_CONTIGUOUS, H5D_CHUNKED or H5D_VIRTUAL
+    ///
+    H5D_layout_t get_layout() const {
+        auto         lock   = detail::library_lock();
+        H5D_layout_t layout = H5Pget_layout(this->get_handle());
+        Utils::runtime_assert(layout >= 0, "H5DatasetCreateProperty get_layout fails.");
+        return layout;
+    }
+
+    ///
+    ///@brief Adds the gzip (deflate) compression filter to the filter pipeline.
+    ///
+    ///@param level Compression level from 0 (none) to 9 (best).
+    ///
+    void set_deflate(unsigned level = 6) {
+        auto lock = detail::library_lock();
+        Utils::runtime_assert(filter_available(H5Z_FILTER_DEFLATE), "Deflate is not available.");
+        herr_t err = H5Pset_deflate(this->writable_handle(), level);
+        Utils::runtime_assert(err >= 0, "H5DatasetCreateProperty set_deflate fails.");
+    }
+
+    ///
+    ///@brief Adds the byte shuffle filter to the filter pipeline. Should precede compression.
+    ///
+    ///
+    void set_shuffle() {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_shuffle(this->writable_handle());
+        Utils::runtime_assert(err >= 0, "H5DatasetCreateProperty set_shuffle fails.");
+    }
+
+    ///
+    ///@brief Adds the scale-offset filter to the filter pipeline.
+    ///
+    ///@param scale_type H5Z_SO_FLOAT_DSCALE or H5Z_SO_FLOAT_ESCALE for floating point data,
+    /// H5Z_SO_INT for integer data.
+    ///@param scale_factor Number of decimal digits kept for D-scaling of floating point data,
+    /// the minimum number of bits for integer data (H5Z_SO_INT_MINBITS_DEFAULT to let the library
+    /// decide).
+    ///
+    void set_scaleoffset(H5Z_SO_scale_type_t scale_type, int scale_factor) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_scaleoffset(this->writable_handle(), scale_type, scale_factor);
+        Utils::runtime_assert(err >= 0, "H5DatasetCreateProperty set_scaleoffset fails.");
+    }
+
+    ///
+    ///@brief Adds the n-bit filter to the filter pipeline. Packs the significant bits of
+    /// datatypes whose precision has been reduced with H5Datatype::set_precision.
+    ///
+    ///
+    void set_nbit() {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_nbit(this->writable_handle());
+        Utils::runtime_assert(err >= 0, "H5DatasetCreateProperty set_nbit fails.");
+    }
+
+    ///
+    ///@brief Adds the Fletcher32 checksum filter to the filter pipeline.
+    ///
+    ///
+    void set_fletcher32() {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_fletcher32(this->writable_handle());
+        Utils::runtime_assert(err >= 0, "H5DatasetCreateProperty set_fletcher32 fails.");
+    }
+
+    ///
+    ///@brief Returns the number of filters in the pipeline.
+    ///
+    ///@return size_t number of filters
+    ///
+    size_t get_nfilters() const {
+        auto lock = detail::library_lock();
+        int  n    = H5Pget_nfilters(this->get_handle());
+        Utils::runtime_assert(n >= 0, "H5DatasetCreateProperty get_nfilters fails.");
+        return size_t(n);
+    }
+
+    ///
+    ///@brief Checks if a filter is available in the linked HDF5 library.
+    ///
+    ///@param filter Filter identifier, e.g. H5Z_FILTER_DEFLATE.
+    ///@return true if available
+    ///@return false otherwise
+    ///
+    static bool filter_available(H5Z_filter_t filter) {
+        auto   lock  = detail::library_lock();
+        htri_t query = H5Zfilter_avail(filter);
+        Utils::runtime_assert(query >= 0, "H5DatasetCreateProperty filter_available fails.");
+        return query > 0;
+    }
+
+    ///
+    ///@brief Guesses a chunk shape for a dataset. The target chunk size grows with the size of
+    /// the dataset from 8 KiB up to 1 MiB, and the dimensions are halved in turn until the chunk
+    /// fits the target. Zero sized dimensions are treated as 1024 elements long.
+    ///
+    ///@param dims Dimensions of the dataset.
+    ///@param element_size Size of a dataset element in bytes.
+    ///@return std::vector<size_t> Chunk dimensions.
+    ///
+    static std::vector<size_t> guess_chunk(const std::vector<size_t>& dims, size_t element_size) {
+
+        constexpr double chunk_base = 16.0 * 1024.0;
+        constexpr double chunk_min  = 8.0 * 1024.0;
+        constexpr double chunk_max  = 1024.0 * 1024.0;
+
+        std::vector<size_t> chunk(dims);
+        for (auto& c : chunk) {
+            if (c == 0) { c = 1024; }
+        }
+
+        auto volume = [&]() {
+            double v = double(element_size);
+            for (auto c : chunk) { v *= double(c); }
+            return v;
+        };
+
+        double dset_size = volume();
+        double target    = chunk_base * std::pow(2.0, std::log10(dset_size / chunk_max));
+        target           = std::min(std::max(target, chunk_min), chunk_max);
+
+        for (size_t i = 0; !chunk.empty(); ++i) {
+
+            double chunk_bytes = volume();
+
+            bool close_to_target = std::abs(chunk_bytes - target) / target < 0.5;
+            if ((chunk_bytes < target || close_to_target) && chunk_bytes < chunk_max) { break; }
+
+            if (chunk_bytes <= double(element_size)) { break; }
+
+            auto& c = chunk[i % chunk.size()];
+            c       = (c + 1) / 2;
+        }
+
+        return chunk;
+    }
+};
 
 struct H5DatasetTransferProperty : public detail::H5Property<PropertyType::DATASET_XFER> {
 
-    void set_collective_mpi_io() {
-        herr_t err = H5Pset_dxpl_mpio(this->get_handle(), H5FD_MPIO_COLLECTIVE);
+    H5DatasetTransferProperty() = default;
+
+    ///
+    ///@brief Construct from a transfer property list identifier, taking ownership.
+    ///
+    ///@param id property list identifier
+    ///
+    explicit H5DatasetTransferProperty(hid_t id)
+        : H5Property(id)
+        , m_collective_required(stored_collective_required()) {}
+
+    ///
+    ///@brief Construct a non-owning view of a transfer property list owned elsewhere.
+    ///
+    ///@param id property list identifier
+    ///
+    H5DatasetTransferProperty(hid_t id, H5Object::Borrowed tag)
+        : H5Property(id, tag)
+        , m_collective_required(stored_collective_required()) {}
+
+    ///
+    ///@brief Transfer profile where every rank accesses the file independently of the others.
+    ///
+    ///@return H5DatasetTransferProperty the property list
+    ///
+    static H5DatasetTransferProperty independent() {
+        H5DatasetTransferProperty ret;
+        ret.set_mpi_io_mode(H5FD_MPIO_INDEPENDENT);
+        return ret;
+    }
+
+    ///
+    ///@brief Transfer profile using collective MPI-IO. All ranks of the file communicator have to
+    ///       take part in every transfer.
+    ///
+    ///@return H5DatasetTransferProperty the property list
+    ///
+    static H5DatasetTransferProperty collective() {
+        H5DatasetTransferProperty ret;
+        ret.set_collective_mpi_io();
+        return ret;
+    }
+
+    ///
+    ///@brief Transfer profile using collective MPI-IO with a fixed chunk optimization instead of
+    ///       letting HDF5 choose per transfer.
+    ///
+    ///@param chunk_opt H5FD_MPIO_CHUNK_ONE_IO to access all chunks in one collective operation,
+    /// H5FD_MPIO_CHUNK_MULTI_IO to decide collective or independent access per chunk
+    ///@return H5DatasetTransferProperty the property list
+    ///
+    static H5DatasetTransferProperty
+    collective_chunked(H5FD_mpio_chunk_opt_t chunk_opt = H5FD_MPIO_CHUNK_ONE_IO) {
+        auto                      lock = detail::library_lock();
+        H5DatasetTransferProperty ret;
+        ret.set_collective_mpi_io();
+        herr_t err = H5Pset_dxpl_mpio_chunk_opt(ret.get_handle(), chunk_opt);
+        Utils::runtime_assert(err >= 0, "H5DatasetTransferProperty collective_chunked fails.");
+        return ret;
+    }
+
+    ///
+    ///@brief Transfer profile using collective MPI-IO which reports a fallback to independent I/O.
+    ///       Read and write calls using it throw a std::runtime_error naming the cause if HDF5
+    ///       did not perform collective I/O.
+    ///
+    ///@return H5DatasetTransferProperty the property list
+    ///
+    static H5DatasetTransferProperty collective_checked() {
+        H5DatasetTransferProperty ret = collective();
+        detail::set_flag(ret.get_handle(), require_collective_flag, true);
+        ret.m_collective_required = true;
+        return ret;
+    }
+
+    ///
+    ///@brief Returns a transfer property list using collective MPI-IO shared by the whole process.
+    ///       It is created on the first call and never modified, so passing it to read and write
+    ///       calls costs nothing.
+    ///
+    ///@return const H5DatasetTransferProperty& the shared collective property list
+    ///
+    static const H5DatasetTransferProperty& collective_default() {
+        // the list is left to the library to free, as it may be shut down before static
+        // destruction
+        static const H5DatasetTransferProperty shared(collective().release(), H5Object::borrowed);
+        return shared;
+    }
+
+    void set_collective_mpi_io() { set_mpi_io_mode(H5FD_MPIO_COLLECTIVE); }
+
+    ///
+    ///@brief Sets the MPI-IO transfer mode.
+    ///
+    ///@param mode H5FD_MPIO_INDEPENDENT or H5FD_MPIO_COLLECTIVE
+    ///
+    void set_mpi_io_mode(H5FD_mpio_xfer_t mode) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_dxpl_mpio(this->writable_handle(), mode);
         Utils::runtime_assert(err >= 0, "set_collective_mpi_io fails.");
     }
+
+    ///
+    ///@brief Returns the MPI-IO transfer mode.
+    ///
+    ///@return H5FD_mpio_xfer_t H5FD_MPIO_INDEPENDENT or H5FD_MPIO_COLLECTIVE
+    ///
+    H5FD_mpio_xfer_t get_mpi_io_mode() const {
+        auto             lock = detail::library_lock();
+        H5FD_mpio_xfer_t mode;
+        herr_t           err = H5Pget_dxpl_mpio(this->get_handle(), &mode);
+        Utils::runtime_assert(err >= 0, "H5DatasetTransferProperty get_mpi_io_mode fails.");
+        return mode;
+    }
+
+    ///
+    ///@brief Keeps the collective semantics of a collective transfer but lets every rank do its
+    ///       low level I/O independently.
+    ///
+    ///@param opt H5FD_MPIO_COLLECTIVE_IO (default) or H5FD_MPIO_INDIVIDUAL_IO
+    ///
+    void set_collective_opt(H5FD_mpio_collective_opt_t opt) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_dxpl_mpio_collective_opt(this->writable_handle(), opt);
+        Utils::runtime_assert(err >= 0, "H5DatasetTransferProperty set_collective_opt fails.");
+    }
+
+    ///
+    ///@brief Returns the I/O mode HDF5 actually used in the last transfer with this list.
+    ///
+    ///@return H5D_mpio_actual_io_mode_t H5D_MPIO_NO_COLLECTIVE if no collective I/O took place
+    ///
+    H5D_mpio_actual_io_mode_t get_actual_io_mode() const {
+        auto                      lock = detail::library_lock();
+        H5D_mpio_actual_io_mode_t mode;
+        herr_t                    err = H5Pget_mpio_actual_io_mode(this->get_handle(), &mode);
+        Utils::runtime_assert(err >= 0, "H5DatasetTransferProperty get_actual_io_mode fails.");
+        return mode;
+    }
+
+    ///
+    ///@brief Returns the chunk optimization HDF5 actually used in the last transfer with this list.
+    ///
+    ///@return H5D_mpio_actual_chunk_opt_mode_t the chunk optimization
+    ///
+    H5D_mpio_actual_chunk_opt_mode_t get_actual_chunk_opt_mode() const {
+        auto                             lock = detail::library_lock();
+        H5D_mpio_actual_chunk_opt_mode_t mode;
+        herr_t err = H5Pget_mpio_actual_chunk_opt_mode(this->get_handle(), &mode);
+        Utils::runtime_assert(err >= 0, "H5DatasetTransferProperty get_actual_chunk_opt fails.");
+        return mode;
+    }
+
+    ///
+    ///@brief Returns why collective I/O was not performed in the last transfer with this list.
+    ///
+    ///@return std::pair<uint32_t, uint32_t> local and global bit fields of
+    /// H5D_mpio_no_collective_cause_t, H5D_MPIO_COLLECTIVE if collective I/O took place
+    ///
+    std::pair<uint32_t, uint32_t> get_no_collective_cause() const {
+        auto     lock = detail::library_lock();
+        uint32_t local, global;
+        herr_t   err = H5Pget_mpio_no_collective_cause(this->get_handle(), &local, &global);
+        Utils::runtime_assert(err >= 0, "H5DatasetTransferProperty get_no_collective_cause fails.");
+        return {local, global};
+    }
+
+    ///
+    ///@brief Checks if the last transfer with this list performed collective I/O.
+    ///
+    ///@return true if some of the I/O was collective
+    ///
+    bool collective_io_performed() const {
+        return get_actual_io_mode() != H5D_MPIO_NO_COLLECTIVE;
+    }
+
+    ///
+    ///@brief Describes the bits of a H5D_mpio_no_collective_cause_t bit field.
+    ///
+    ///@param cause bit field returned by get_no_collective_cause()
+    ///@return std::string comma separated causes, "collective" if no bits are set
+    ///
+    static std::string describe_no_collective_cause(uint32_t cause) {
+        static const std::pair<uint32_t, const char*> causes[] = {
+            {H5D_MPIO_SET_INDEPENDENT, "independent I/O was requested"},
+            {H5D_MPIO_DATATYPE_CONVERSION, "datatype conversion"},
+            {H5D_MPIO_DATA_TRANSFORMS, "data transforms"},
+            {H5D_MPIO_MPI_OPT_TYPES_ENV_VAR_DISABLED, "MPI derived types disabled"},
+            {H5D_MPIO_NOT_SIMPLE_OR_SCALAR_DATASPACES, "dataspace neither simple nor scalar"},
+            {H5D_MPIO_NOT_CONTIGUOUS_OR_CHUNKED_DATASET, "dataset neither contiguous nor chunked"},
+            {H5D_MPIO_PARALLEL_FILTERED_WRITES_DISABLED, "parallel filtered writes disabled"},
+            {H5D_MPIO_ERROR_WHILE_CHECKING_COLLECTIVE_POSSIBLE, "error checking collective I/O"}};
+
+        if (cause == H5D_MPIO_COLLECTIVE) { return "collective"; }
+        std::string ret;
+        for (const auto& [bit, text] : causes) {
+            if (cause & bit) {
+                if (!ret.empty()) { ret += ", "; }
+                ret += text;
+            }
+        }
+        return ret;
+    }
+
+    ///
+    ///@brief Checks if transfers using this list have to report a fallback to independent I/O.
+    ///       Read from the list once, when the handle is constructed, as it is checked by every
+    ///       read and write call.
+    ///
+    ///@return true if created with collective_checked()
+    ///
+    bool collective_required() const { return m_collective_required; }
+
+    ///
+    ///@brief Throws if collective I/O is required by this list but the last transfer with it
+    ///       fell back to independent I/O. Called by the H5Dataset read and write calls. Unlike
+    ///       the other checks of the wrapper, it throws also in builds without DEBUG, since the
+    ///       list has been created with collective_checked() to request it.
+    ///
+    ///@param transfer_status return value of the transfer, which is not checked if it failed, as
+    ///                       the I/O mode of a failed transfer is not reported
+    ///
+    void check_collective(herr_t transfer_status) const {
+        if (transfer_status < 0 || !collective_required() || collective_io_performed()) {
+            return;
+        }
+        auto [local, global] = get_no_collective_cause();
+        throw std::runtime_error("Collective I/O fell back to independent I/O, local cause: " +
+                                 describe_no_collective_cause(local) +
+                                 ", global cause: " + describe_no_collective_cause(global) + ".");
+    }
+
+    ///
+    ///@brief Allows read and write calls using this property list to convert between a memory
+    ///       datatype and a differing file datatype. Without this, a datatype mismatch is an error.
+    ///       The permission is kept in the list itself, so copies and other handles of the list
+    ///       share it.
+    ///
+    ///@param buffer_size Size in bytes of the type conversion buffer HDF5 allocates per
+    ///                   transfer. If zero, the default size of 1 MiB is kept.
+    ///
+    void allow_type_conversion(size_t buffer_size = 0) {
+        auto lock = detail::library_lock();
+        detail::set_flag(this->writable_handle(), type_conversion_flag, true);
+
+        if (buffer_size == 0) { return; }
+
+        // left to HDF5 to allocate, so that the list never points to memory of a wrapper
+        herr_t err = H5Pset_buffer(this->writable_handle(), buffer_size, NULL, NULL);
+        Utils::runtime_assert(err >= 0, "allow_type_conversion fails.");
+    }
+
+    ///
+    ///@brief Checks if datatype conversion has been enabled for this property list.
+    ///
+    ///@return true if memory and file datatypes are allowed to differ
+    ///@return false otherwise
+    ///
+    bool type_conversion_allowed() const {
+        return detail::get_flag(this->get_handle(), type_conversion_flag);
+    }
+
+    ///
+    ///@brief Get the size of the type conversion buffer.
+    ///
+    ///@return size_t size of the conversion buffer in bytes
+    ///
+    size_t get_conversion_buffer_size() const {
+        auto lock = detail::library_lock();
+        return H5Pget_buffer(this->get_handle(), NULL, NULL);
+    }
+
+private:
+    static constexpr const char* type_conversion_flag    = "H5Wrapper.type_conversion";
+    static constexpr const char* require_collective_flag = "H5Wrapper.require_collective";
+
+    bool m_collective_required = false;
+
+    bool stored_collective_required() const {
+        return this->get_handle() > 0 &&
+               detail::get_flag(this->get_handle(), require_collective_flag);
+    }
 };
 
-struct H5DatatypeAccessProperty : public detail::H5Property<PropertyType::DATATYPE_ACCESS> {};
+struct H5DatatypeAccessProperty : public detail::H5Property<PropertyType::DATATYPE_ACCESS> {
+    using detail::H5Property<PropertyType::DATATYPE_ACCESS>::H5Property;
+};
 
-struct H5DatatypeCreateProperty : public detail::H5Property<PropertyType::DATATYPE_CREATE> {};
+struct H5DatatypeCreateProperty : public detail::H5Property<PropertyType::DATATYPE_CREATE> {
+    using detail::H5Property<PropertyType::DATATYPE_CREATE>::H5Property;
+};
 
 struct H5FileAccessProperty : public detail::H5Property<PropertyType::FILE_ACCESS> {
 
+    static constexpr size_t default_core_increment = size_t(1) << 20;
+
     H5FileAccessProperty() = default;
 
     explicit H5FileAccessProperty(hid_t id) : detail::H5Property<PropertyType::FILE_ACCESS>(id) {}
 
-    void store_mpi_info(MPI_Comm comm, MPI_Info info) const{
+    H5FileAccessProperty(hid_t id, H5Object::Borrowed tag)
+        : detail::H5Property<PropertyType::FILE_ACCESS>(id, tag) {}
+
+    ///
+    ///@brief Selects the MPI-IO file driver. The communicator and the hints are duplicated by
+    ///       HDF5, so they can be freed after the call. All ranks of the communicator have to
+    ///       take part in the collective file operations, other ranks do not.
+    ///
+    ///@param comm communicator of the ranks accessing the file
+    ///@param hints MPI-IO hints passed to MPI_File_open
+    ///
+    void set_mpi(MPI_Comm comm = MPI_COMM_WORLD, const H5MpiInfo& hints = H5MpiInfo()) {
+        store_mpi_info(comm, ~hints);
+    }
 
-        herr_t err = H5Pset_fapl_mpio(this->get_handle(), comm, info);
+    ///
+    ///@brief Selects the MPI-IO file driver with a raw communicator and info object.
+    ///
+    ///@param comm communicator of the ranks accessing the file
+    ///@param info MPI-IO hints, may be MPI_INFO_NULL
+    ///
+    void store_mpi_info(MPI_Comm comm, MPI_Info info) const {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_fapl_mpio(this->writable_handle(), comm, info);
         Utils::runtime_assert(err >= 0, "store_mpi_info fails.");
+        detail::set_flag(this->writable_handle(), serial_flag, false);
+    }
+
+    ///
+    ///@brief Selects the serial (sec2) file driver, so that the file is accessed independently by
+    ///       the calling rank even if MPI has been initialized.
+    ///
+    ///
+    void set_serial() {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_fapl_sec2(this->writable_handle());
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_serial fails.");
+        detail::set_flag(this->writable_handle(), serial_flag, true);
+    }
+
+    ///
+    ///@brief Selects the core driver, which holds the whole file in memory. The file is accessed
+    ///       independently by the calling rank even if MPI has been initialized.
+    ///
+    ///@param increment Number of bytes the memory of the file grows by
+    ///@param backing_store Write the contents to the named file on disk when the file is closed
+    ///
+    void set_core(size_t increment = default_core_increment, bool backing_store = false) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_fapl_core(this->writable_handle(), increment, backing_store);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_core fails.");
+        detail::set_flag(this->writable_handle(), serial_flag, true);
+    }
+
+    ///
+    ///@brief Returns the increment of a property list using the core driver.
+    ///
+    ///@return size_t number of bytes the memory of the file grows by
+    ///
+    size_t get_core_increment() const { return get_core().first; }
+
+    ///
+    ///@brief Checks if a property list using the core driver writes a backing store.
+    ///
+    ///@return true if the contents go to disk when the file is closed
+    ///
+    bool get_core_backing_store() const { return get_core().second; }
+
+    ///
+    ///@brief Sets the initial contents of a file opened with the core driver to a copy of a file
+    ///       image, e.g. one returned by H5File::to_image.
+    ///
+    ///@param data first byte of the image
+    ///@param size size of the image in bytes
+    ///
+    void set_file_image(const void* data, size_t size) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_file_image(this->writable_handle(), const_cast<void*>(data), size);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_file_image fails.");
+    }
+
+    ///
+    ///@brief Sets the size of the page buffer. Whole pages are cached, so accessing many small
+    ///       objects costs one I/O per page instead of one per access. The file has to use paged
+    ///       aggregation, see H5FileCreateProperty::set_paged_aggregation, and the size has to be
+    ///       at least one page of the file, it is rounded down to a multiple of the page size.
+    ///       H5File::create throws std::runtime_error if either does not hold, opening a file
+    ///       which does not fails. Not supported by the MPI-IO driver of HDF5 before 1.14.
+    ///       Throws std::runtime_error, also without DEBUG, if the percentages exceed 100.
+    ///
+    ///@param bytes size of the page buffer, zero disables it
+    ///@param min_meta_percent share of the buffer reserved for metadata pages
+    ///@param min_raw_percent share of the buffer reserved for raw data pages
+    ///
+    void set_page_buffer_size(size_t   bytes,
+                              unsigned min_meta_percent = 0,
+                              unsigned min_raw_percent  = 0) {
+        if (min_meta_percent > 100 || min_raw_percent > 100 - min_meta_percent) {
+            throw std::runtime_error(
+                "H5FileAccessProperty set_page_buffer_size: percentages exceed 100.");
+        }
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_page_buffer_size(
+            this->writable_handle(), bytes, min_meta_percent, min_raw_percent);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_page_buffer_size fails.");
+    }
+
+    ///
+    ///@brief Returns the size of the page buffer.
+    ///
+    ///@return size_t size in bytes, zero if disabled
+    ///
+    size_t get_page_buffer_size() const {
+        auto     lock = detail::library_lock();
+        size_t   bytes;
+        unsigned min_meta_percent, min_raw_percent;
+        herr_t   err = H5Pget_page_buffer_size(
+            this->get_handle(), &bytes, &min_meta_percent, &min_raw_percent);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_page_buffer_size fails.");
+        return bytes;
+    }
+
+    ///
+    ///@brief Bounds the metadata cache of the file, which holds object headers, group B-trees
+    ///       and heaps. By default the cache starts at 2 MiB and grows adaptively up to 32 MiB per
+    ///       open file when it misses often, e.g. while walking a hierarchy of many groups. A
+    ///       cache of fixed size (adaptive = false) keeps a long running reader within a known
+    ///       memory budget at the cost of a lower hit rate.
+    ///
+    ///@param initial_size size of the cache when the file is opened in bytes
+    ///@param min_size smallest size adaptive resizing shrinks the cache to
+    ///@param max_size largest size adaptive resizing grows the cache to, at most 128 MiB
+    ///@param adaptive resize the cache between min_size and max_size depending on its hit rate
+    ///
+    void set_metadata_cache(size_t initial_size,
+                            size_t min_size,
+                            size_t max_size,
+                            bool   adaptive = true) {
+        auto lock = detail::library_lock();
+        Utils::runtime_assert(min_size <= initial_size && initial_size <= max_size,
+                              "H5FileAccessProperty metadata cache sizes out of order.");
+        H5AC_cache_config_t config = get_metadata_cache();
+        config.set_initial_size    = true;
+        config.initial_size        = initial_size;
+        config.min_size            = min_size;
+        config.max_size            = max_size;
+        if (adaptive) {
+            config.incr_mode       = H5C_incr__threshold;
+            config.flash_incr_mode = H5C_flash_incr__add_space;
+            config.decr_mode       = H5C_decr__age_out_with_threshold;
+        } else {
+            config.incr_mode       = H5C_incr__off;
+            config.flash_incr_mode = H5C_flash_incr__off;
+            config.decr_mode       = H5C_decr__off;
+        }
+        herr_t err = H5Pset_mdc_config(this->writable_handle(), &config);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_metadata_cache fails.");
+    }
+
+    size_t get_metadata_cache_initial_size() const { return get_metadata_cache().initial_size; }
+    size_t get_metadata_cache_min_size() const { return get_metadata_cache().min_size; }
+    size_t get_metadata_cache_max_size() const { return get_metadata_cache().max_size; }
+
+    ///
+    ///@brief Checks if the metadata cache is resized depending on its hit rate.
+    ///
+    ///@return true if adaptive
+    ///
+    bool get_metadata_cache_adaptive() const {
+        const auto config = get_metadata_cache();
+        return config.incr_mode != H5C_incr__off || config.decr_mode != H5C_decr__off;
+    }
+
+    ///
+    ///@brief Evicts the metadata of an object from the metadata cache when its last handle is
+    ///       closed, instead of keeping it until the cache needs the space. Readers which open
+    ///       and close many objects once, e.g. every group found by H5Location::link_names, then
+    ///       only cache the metadata of the objects currently open. Not supported by the MPI-IO
+    ///       driver of HDF5 before 1.14, opening the file fails.
+    ///
+    ///@param evict evict on close
+    ///
+    void set_evict_on_close(bool evict = true) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_evict_on_close(this->writable_handle(), evict);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_evict_on_close fails.");
+    }
+
+    ///
+    ///@brief Checks if objects are evicted from the metadata cache when closed.
+    ///
+    ///@return true if evicted
+    ///
+    bool get_evict_on_close() const {
+        auto    lock = detail::library_lock();
+        hbool_t evict;
+        herr_t  err = H5Pget_evict_on_close(this->get_handle(), &evict);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_evict_on_close fails.");
+        return evict != 0;
+    }
+
+    ///
+    ///@brief Aligns the file addresses of objects of at least threshold bytes, i.e. the data of
+    ///       contiguous datasets and every chunk, to multiples of alignment. With alignment set to
+    ///       the stripe size of a parallel file system, a large write covers whole stripes
+    ///       instead of straddling two, which otherwise locks and rewrites partial stripes on two
+    ///       servers. Costs up to alignment - 1 bytes of padding per aligned object.
+    ///
+    ///@param threshold smallest object in bytes which is aligned
+    ///@param alignment alignment in bytes, e.g. the stripe size
+    ///
+    void set_alignment(size_t threshold, size_t alignment) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_alignment(this->writable_handle(), threshold, alignment);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_alignment fails.");
+    }
+
+    size_t get_alignment_threshold() const { return get_alignment_pair().first; }
+    size_t get_alignment() const { return get_alignment_pair().second; }
+
+    ///
+    ///@brief Sets the size of the blocks metadata is aggregated into, 2048 bytes by default.
+    ///       Larger blocks keep the metadata of many objects together instead of interleaving it
+    ///       with raw data, so fewer and larger metadata writes hit the file system.
+    ///
+    ///@param size block size in bytes, zero disables aggregation
+    ///
+    void set_meta_block_size(size_t size) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_meta_block_size(this->writable_handle(), size);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_meta_block_size fails.");
+    }
+
+    ///
+    ///@brief Returns the size of the blocks metadata is aggregated into.
+    ///
+    ///@return size_t block size in bytes
+    ///
+    size_t get_meta_block_size() const {
+        auto    lock = detail::library_lock();
+        hsize_t size;
+        herr_t  err = H5Pget_meta_block_size(this->get_handle(), &size);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_meta_block_size fails.");
+        return size_t(size);
+    }
+
+    ///
+    ///@brief Sets the size of the blocks the raw data of small contiguous datasets is aggregated
+    ///       into, 2048 bytes by default.
+    ///
+    ///@param size block size in bytes, zero disables aggregation
+    ///
+    void set_small_data_block_size(size_t size) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_small_data_block_size(this->writable_handle(), size);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_small_data_block_size fails.");
+    }
+
+    ///
+    ///@brief Returns the size of the blocks small raw data is aggregated into.
+    ///
+    ///@return size_t block size in bytes
+    ///
+    size_t get_small_data_block_size() const {
+        auto    lock = detail::library_lock();
+        hsize_t size;
+        herr_t  err = H5Pget_small_data_block_size(this->get_handle(), &size);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_small_data_block_size fails.");
+        return size_t(size);
+    }
+
+    ///
+    ///@brief Sets the size of the sieve buffer, 64 KiB by default, which collects the pieces of
+    ///       a strided selection of a contiguous dataset into one read or write of the covering
+    ///       range. Not used by the MPI-IO driver.
+    ///
+    ///@param size buffer size in bytes
+    ///
+    void set_sieve_buf_size(size_t size) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_sieve_buf_size(this->writable_handle(), size);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_sieve_buf_size fails.");
+    }
+
+    ///
+    ///@brief Returns the size of the sieve buffer.
+    ///
+    ///@return size_t buffer size in bytes
+    ///
+    size_t get_sieve_buf_size() const {
+        auto   lock = detail::library_lock();
+        size_t size;
+        herr_t err = H5Pget_sieve_buf_size(this->get_handle(), &size);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_sieve_buf_size fails.");
+        return size;
+    }
+
+    ///
+    ///@brief Checks if a rank-local driver has been explicitly selected with set_serial() or
+    ///       set_core().
+    ///
+    ///@return true if the file is to be accessed serially
+    ///
+    bool is_serial() const { return detail::get_flag(this->get_handle(), serial_flag); }
+
+    ///
+    ///@brief Returns the file driver selected by the property list.
+    ///
+    ///@return hid_t driver identifier, e.g. H5FD_SEC2 or H5FD_MPIO
+    ///
+    hid_t get_driver() const {
+        auto  lock   = detail::library_lock();
+        hid_t driver = H5Pget_driver(this->get_handle());
+        Utils::runtime_assert(driver >= 0, "H5FileAccessProperty get_driver fails.");
+        return driver;
+    }
+
+    ///
+    ///@brief Returns a copy of the MPI-IO hints of a property list using the MPI-IO driver.
+    ///
+    ///@return H5MpiInfo the hints
+    ///
+    H5MpiInfo get_mpi_hints() const {
+        auto     lock = detail::library_lock();
+        MPI_Comm comm = MPI_COMM_NULL;
+        MPI_Info info = MPI_INFO_NULL;
+        herr_t   err  = H5Pget_fapl_mpio(this->get_handle(), &comm, &info);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_mpi_hints fails.");
+        if (comm != MPI_COMM_NULL) { MPI_Comm_free(&comm); }
+        return H5MpiInfo::adopt(info);
+    }
+
+    ///
+    ///@brief Makes the metadata reads and writes of the file collective. With collective reads,
+    ///       one rank reads the metadata touched by e.g. H5Dataset::open and H5Group::open and
+    ///       broadcasts it, instead of every rank hitting the file system. All ranks then have to
+    ///       call every metadata reading operation, in the same order.
+    ///
+    ///@param reads make metadata reads collective
+    ///@param writes make metadata writes collective, written by aggregated MPI-IO calls
+    ///
+    void set_collective_metadata(bool reads = true, bool writes = true) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_all_coll_metadata_ops(this->writable_handle(), reads);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_collective_metadata fails.");
+        err = H5Pset_coll_metadata_write(this->writable_handle(), writes);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty set_collective_metadata fails.");
+    }
+
+    ///
+    ///@brief Checks if metadata reads are collective.
+    ///
+    ///@return true if collective
+    ///
+    bool get_collective_metadata_reads() const {
+        auto    lock = detail::library_lock();
+        hbool_t is_collective;
+        herr_t  err = H5Pget_all_coll_metadata_ops(this->get_handle(), &is_collective);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_collective_metadata fails.");
+        return is_collective;
+    }
+
+    ///
+    ///@brief Checks if metadata writes are collective.
+    ///
+    ///@return true if collective
+    ///
+    bool get_collective_metadata_writes() const {
+        auto    lock = detail::library_lock();
+        hbool_t is_collective;
+        herr_t  err = H5Pget_coll_metadata_write(this->get_handle(), &is_collective);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_collective_metadata fails.");
+        return is_collective;
+    }
+
+    ///
+    ///@brief Returns an independent copy of the property list.
+    ///
+    ///@return H5FileAccessProperty the copy
+    ///
+    H5FileAccessProperty copy() const {
+        auto  lock = detail::library_lock();
+        hid_t id   = H5Pcopy(this->get_handle());
+        Utils::runtime_assert(id >= 0, "H5FileAccessProperty copy fails.");
+        return H5FileAccessProperty(id);
+    }
+
+private:
+    static constexpr const char* serial_flag = "H5Wrapper.serial";
+
+    std::pair<size_t, bool> get_core() const {
+        auto    lock = detail::library_lock();
+        size_t  increment;
+        hbool_t backing_store;
+        herr_t  err = H5Pget_fapl_core(this->get_handle(), &increment, &backing_store);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_core fails.");
+        return {increment, backing_store != 0};
+    }
+
+    std::pair<size_t, size_t> get_alignment_pair() const {
+        auto    lock = detail::library_lock();
+        hsize_t threshold, alignment;
+        herr_t  err = H5Pget_alignment(this->get_handle(), &threshold, &alignment);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_alignment fails.");
+        return {size_t(threshold), size_t(alignment)};
+    }
+
+    H5AC_cache_config_t get_metadata_cache() const {
+        auto                lock = detail::library_lock();
+        H5AC_cache_config_t config;
+        config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+        herr_t err     = H5Pget_mdc_config(this->get_handle(), &config);
+        Utils::runtime_assert(err >= 0, "H5FileAccessProperty get_metadata_cache fails.");
+        return config;
     }
 };
 
 struct H5FileCreateProperty : public detail::H5Property<PropertyType::FILE_CREATE> {
 
+    static constexpr size_t default_page_size = 4096;
+
     H5FileCreateProperty() = default;
 
     explicit H5FileCreateProperty(hid_t id) : detail::H5Property<PropertyType::FILE_CREATE>(id) {}
 
+    H5FileCreateProperty(hid_t id, H5Object::Borrowed tag)
+        : detail::H5Property<PropertyType::FILE_CREATE>(id, tag) {}
+
+    ///
+    ///@brief Sets how the space in the file is allocated.
+    ///
+    ///@param strategy H5F_FSPACE_STRATEGY_FSM_AGGR (default), H5F_FSPACE_STRATEGY_PAGE,
+    /// H5F_FSPACE_STRATEGY_AGGR or H5F_FSPACE_STRATEGY_NONE
+    ///@param persist keep tracking free space across closing and reopening the file
+    ///@param threshold smallest free section in bytes which is tracked
+    ///
+    void set_file_space_strategy(H5F_fspace_strategy_t strategy,
+                                 bool                  persist   = false,
+                                 size_t                threshold = 1) {
+        auto   lock = detail::library_lock();
+        herr_t err  =
+            H5Pset_file_space_strategy(this->writable_handle(), strategy, persist, threshold);
+        Utils::runtime_assert(err >= 0, "H5FileCreateProperty set_file_space_strategy fails.");
+    }
+
+    ///
+    ///@brief Returns the file space strategy.
+    ///
+    ///@return H5F_fspace_strategy_t the strategy
+    ///
+    H5F_fspace_strategy_t get_file_space_strategy() const { return get_strategy().strategy; }
+
+    ///
+    ///@brief Checks if free space is tracked across closing and reopening the file.
+    ///
+    ///@return true if persistent
+    ///
+    bool get_file_space_persist() const { return get_strategy().persist; }
+
+    ///
+    ///@brief Sets the page size of files using the paged strategy.
+    ///
+    ///@param page_size page size in bytes, at least 512
+    ///
+    void set_file_space_page_size(size_t page_size) {
+        auto   lock = detail::library_lock();
+        herr_t err  = H5Pset_file_space_page_size(this->writable_handle(), page_size);
+        Utils::runtime_assert(err >= 0, "H5FileCreateProperty set_file_space_page_size fails.");
+    }
+
+    ///
+    ///@brief Returns the page size of files using the paged strategy.
+    ///
+    ///@return size_t page size in bytes
+    ///
+    size_t get_file_space_page_size() const {
+        auto    lock = detail::library_lock();
+        hsize_t page_size;
+        herr_t  err = H5Pget_file_space_page_size(this->get_handle(), &page_size);
+        Utils::runtime_assert(err >= 0, "H5FileCreateProperty get_file_space_page_size fails.");
+        return size_t(page_size);
+    }
+
+    ///
+    ///@brief Selects paged aggregation. Metadata and raw data are allocated in separate pages of
+    ///       the given size, so the metadata of many small objects ends up in few pages, which a
+    ///       page buffer (H5FileAccessProperty::set_page_buffer_size) reads and writes whole
+    ///       instead of issuing one small I/O per metadata access. The page size should match
+    ///       the block or stripe size of the file system.
+    ///
+    ///@param page_size page size in bytes
+    ///@param persist keep tracking free space across closing and reopening the file
+    ///
+    void set_paged_aggregation(size_t page_size = default_page_size, bool persist = false) {
+        set_file_space_strategy(H5F_FSPACE_STRATEGY_PAGE, persist);
+        set_file_space_page_size(page_size);
+    }
+
+private:
+    struct Strategy {
+        H5F_fspace_strategy_t strategy;
+        bool                  persist;
+    };
+
+    Strategy get_strategy() const {
+        auto                  lock = detail::library_lock();
+        H5F_fspace_strategy_t strategy;
+        hbool_t               persist;
+        hsize_t               threshold;
+        herr_t                err =
+            H5Pget_file_space_strategy(this->get_handle(), &strategy, &persist, &threshold);
+        Utils::runtime_assert(err >= 0, "H5FileCreateProperty get_file_space_strategy fails.");
+        return {strategy, persist != 0};
+    }
+};
+
+struct H5FileMountProperty : public detail::H5Property<PropertyType::FILE_MOUNT> {
+    using detail::H5Property<PropertyType::FILE_MOUNT>::H5Property;
 };
 
-struct H5FileMountProperty : public detail::H5Property<PropertyType::FILE_MOUNT> {};
+struct H5GroupAccessProperty : public detail::H5Property<PropertyType::GROUP_ACCESS> {
+    using detail::H5Property<PropertyType::GROUP_ACCESS>::H5Property;
+};
 
-struct H5GroupAccessProperty : public detail::H5Property<PropertyType::GROUP_ACCESS> {};
+struct H5GroupCreateProperty : public detail::H5Property<PropertyType::GROUP_CREATE> {
 
-struct H5GroupCreateProperty : public detail::H5Property<PropertyType::GROUP_CREATE> {};
+    using detail::H5Property<PropertyType::GROUP_CREATE>::H5Property;
 
-struct H5LinkAccessProperty : public detail::H5Property<PropertyType::LINK_ACCESS> {};
+    ///
+    ///@brief Sets when the attributes of the group switch between compact and dense storage.
+    ///
+    ///@param max_compact maximum number of attributes stored in the object header, 8 by default
+    ///@param min_dense minimum number of attributes stored densely, 6 by default
+    ///
+    void set_attribute_phase_change(unsigned max_compact, unsigned min_dense) {
+        detail::set_attribute_phase_change(this->writable_handle(), max_compact, min_dense);
+    }
+
+    ///
+    ///@brief Stores all attributes of the group densely, for objects with many attributes.
+    ///
+    ///
+    void set_dense_attributes() { set_attribute_phase_change(0, 0); }
+
+    ///
+    ///@brief Returns the attribute storage thresholds.
+    ///
+    ///@return std::pair<unsigned, unsigned> max_compact and min_dense
+    ///
+    std::pair<unsigned, unsigned> get_attribute_phase_change() const {
+        return detail::get_attribute_phase_change(this->get_handle());
+    }
+};
+
+struct H5LinkAccessProperty : public detail::H5Property<PropertyType::LINK_ACCESS> {
+    using detail::H5Property<PropertyType::LINK_ACCESS>::H5Property;
+};
 
 struct H5LinkCreateProperty : public detail::H5Property<PropertyType::LINK_CREATE> {
 
+    using detail::H5Property<PropertyType::LINK_CREATE>::H5Property;
+
     void set_create_intermediate_groups() {
-        auto err = H5Pset_create_intermediate_group(this->get_handle(), 1);
+        auto lock = detail::library_lock();
+        auto err  = H5Pset_create_intermediate_group(this->writable_handle(), 1);
         Utils::runtime_assert(err >= 0, "Set create_intermediate_groups fails.");
     }
 };
 
-struct H5ObjectCopyProperty : public detail::H5Property<PropertyType::OBJECT_COPY> {};
+struct H5ObjectCopyProperty : public detail::H5Property<PropertyType::OBJECT_COPY> {
+    using detail::H5Property<PropertyType::OBJECT_COPY>::H5Property;
+};
 
-struct H5ObjectCreateProperty : public detail::H5Property<PropertyType::OBJECT_CREATE> {};
+struct H5ObjectCreateProperty : public detail::H5Property<PropertyType::OBJECT_CREATE> {
+    using detail::H5Property<PropertyType::OBJECT_CREATE>::H5Property;
+};
 
-struct H5StringCreateProperty : public detail::H5Property<PropertyType::STRING_CREATE> {};
+struct H5StringCreateProperty : public detail::H5Property<PropertyType::STRING_CREATE> {
+    using detail::H5Property<PropertyType::STRING_CREATE>::H5Property;
+};
+
+///
+///@brief Returns a view of the library default property list of a type, e.g.
+///       H5P_DATASET_XFER_DEFAULT, shared by the whole process. Used as the default argument of
+///       the create, open, read and write calls, so they do not create and close a property list
+///       each time. Like every view, it and its copies are read-only; create a new property
+///       object to change settings. Library default lists are internal identifiers, so
+///       is_valid() reports false for them.
+///
+///@tparam P property type, e.g. H5DatasetTransferProperty
+///@return const P& the default property list
+///
+template <class P> const P& default_property() {
+    static const P view(detail::to_h5_default(P::property_type), H5Object::borrowed);
+    return view;
+}
 
 } // namespace H5Wrapper
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <hdf5.h>
+#include <type_traits> //std::void_t
+#include <utility>     //std::exchange, std::move
+
+#include "h5_dataset.hpp"
+#include "h5_dataspace.hpp"
+#include "h5_datatype.hpp"
+#include "h5_object.hpp"
+#include "h5_property.hpp"
+
+#include "runtime_assert.hpp"
+
+namespace H5Wrapper {
+
+namespace detail {
+
+///
+///@brief State shared by the views of an identifier. Views without state are constructed from
+///       the identifier alone.
+///
+template <class View, class = void> struct H5ViewState {
+    View view(hid_t id) const { return View(id, H5Object::borrowed); }
+    void reset() noexcept {}
+};
+
+///
+///@brief State shared by the views of a dataset: the metadata cache, so that the dataspace and
+///       datatype are queried once for all views instead of once per view.
+///
+template <class View> struct H5ViewState<View, std::void_t<typename View::SharedMetadata>> {
+    mutable typename View::SharedMetadata metadata;
+
+    View view(hid_t id) const {
+        if (!metadata) { metadata = View::make_metadata(); }
+        return View(id, H5Object::borrowed, metadata);
+    }
+    void reset() noexcept { metadata.reset(); }
+};
+
+} // namespace detail
+
+///
+///@brief Move-only owner of an HDF5 identifier. Unlike the reference counted H5Object handles,
+///       it never touches the HDF5 identifier table after creation: moves only copy the
+///       identifier and the destructor calls the close function given as a template parameter.
+///       The existing classes are reached through view(), which returns a non-owning View of the
+///       identifier that can be passed wherever a View is expected.
+///
+///@tparam Close close function of the identifier kind, e.g. H5Sclose
+///@tparam View class of the non-owning view, constructible from (hid_t, H5Object::Borrowed)
+///
+template <herr_t (*Close)(hid_t), class View> class H5UniqueHandle {
+
+public:
+    H5UniqueHandle() noexcept = default;
+
+    ///
+    ///@brief Takes the ownership of an identifier.
+    ///
+    ///@param id identifier to close on destruction
+    ///
+    explicit H5UniqueHandle(hid_t id)
+        : m_handle(id) {
+        Utils::runtime_assert(m_handle >= 0, "H5UniqueHandle constructor fails. Invalid hid.");
+    }
+
+    ///
+    ///@brief Takes over the reference held by a reference counted handle, which is reset. No
+    ///       state is lost: the property classes keep theirs in the property list, and the views
+    ///       returned by view() query the metadata of a dataset again, once for all of them.
+    ///
+    ///@param object handle to take the reference from
+    ///
+    explicit H5UniqueHandle(View&& object)
+        : m_handle(object.release()) {}
+
+    H5UniqueHandle(const H5UniqueHandle&) = delete;
+    H5UniqueHandle& operator=(const H5UniqueHandle&) = delete;
+
+    H5UniqueHandle(H5UniqueHandle&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, 0))
+        , m_state(std::move(other.m_state)) {
+        other.m_state.reset();
+    }
+
+    H5UniqueHandle& operator=(H5UniqueHandle&& other) noexcept {
+        if (this != &other) {
+            reset(std::exchange(other.m_handle, 0));
+            m_state = std::move(other.m_state);
+            other.m_state.reset();
+        }
+        return *this;
+    }
+
+    ~H5UniqueHandle() {
+        if (m_handle > 0) {
+            auto lock = detail::library_lock();
+            Close(m_handle);
+        }
+    }
+
+    hid_t operator~() const noexcept { return m_handle; }
+
+    hid_t get_handle() const noexcept { return m_handle; }
+
+    ///
+    ///@brief Checks if an identifier is owned.
+    ///
+    ///@return true if the identifier is nonzero
+    ///
+    explicit operator bool() const noexcept { return m_handle > 0; }
+
+    ///
+    ///@brief Returns a non-owning view of the identifier. The view must not outlive this handle.
+    ///       The views of a dataset share one metadata cache.
+    ///
+    ///@return View the view
+    ///
+    View view() const { return m_state.view(m_handle); }
+
+    ///
+    ///@brief Gives up the ownership of the identifier without closing it.
+    ///
+    ///@return hid_t the identifier the caller now has to close
+    ///
+    hid_t release() noexcept {
+        m_state.reset();
+        return std::exchange(m_handle, 0);
+    }
+
+    ///
+    ///@brief Closes the owned identifier, if any, and takes the ownership of another one.
+    ///
+    ///@param id identifier to own, zero to own nothing
+    ///
+    void reset(hid_t id = 0) {
+        if (m_handle > 0) {
+            auto   lock = detail::library_lock();
+            herr_t err  = Close(m_handle);
+            Utils::runtime_assert(err >= 0, "H5UniqueHandle close fails.");
+        }
+        m_state.reset();
+        m_handle = id;
+    }
+
+    ///
+    ///@brief Closes the owned identifier.
+    ///
+    ///
+    void close() { reset(); }
+
+private:
+    hid_t                     m_handle = 0;
+    detail::H5ViewState<View> m_state;
+};
+
+using H5UniqueDataset   = H5UniqueHandle<&H5Dclose, H5Dataset>;
+using H5UniqueDataspace = H5UniqueHandle<&H5Sclose, H5Dataspace>;
+using H5UniqueDatatype  = H5UniqueHandle<&H5Tclose, H5Datatype>;
+
+template <class Property> using H5UniqueProperty = H5UniqueHandle<&H5Pclose, Property>;
+
+} // namespace H5Wrapper
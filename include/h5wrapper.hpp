@@ -1,5 +1,10 @@
 #pragma once
 
+#include "bits/h5_append_stream.hpp"
+#include "bits/h5_async_writer.hpp"
+#include "bits/h5_attribute.hpp"
+#include "bits/h5_buffer.hpp"
+#include "bits/h5_column.hpp"
 #include "bits/h5_dataset.hpp"
 #include "bits/h5_dataspace_all.hpp"
 #include "bits/h5_dataspace_hyperslab.hpp"
@@ -9,12 +14,19 @@
 #include "bits/h5_datatype_array.hpp"
 #include "bits/h5_datatype_compound.hpp"
 #include "bits/h5_datatype_creator.hpp"
+#include "bits/h5_datatype_reflection.hpp"
 #include "bits/h5_datatype.hpp"
+#include "bits/h5_distributed_array.hpp"
 #include "bits/h5_file.hpp"
 #include "bits/h5_functions.hpp"
 #include "bits/h5_group.hpp"
+#include "bits/h5_library_lock.hpp"
 #include "bits/h5_location.hpp"
+#include "bits/h5_memory_view.hpp"
+#include "bits/h5_mpi_info.hpp"
 #include "bits/h5_object.hpp"
+#include "bits/h5_path_index.hpp"
 #include "bits/h5_property.hpp"
+#include "bits/h5_unique_handle.hpp"
 #include "bits/is_h5_convertible.hpp"
 #include "bits/is_parallel.hpp"
@@ -1,6 +1,29 @@
 #include "catch.hpp"
 
 #include "h5wrapper.hpp"
+#include <map>
+
+struct TestCell {
+    size_t                index;
+    std::array<double, 2> weights;
+};
+H5WRAPPER_COMPOUND(TestCell, index, weights)
+
+// padded in memory: 4 bytes after id and after mass
+struct TestParticle {
+    int      id;
+    double   position[3];
+    float    mass;
+    TestCell cell;
+};
+H5WRAPPER_COMPOUND(TestParticle, id, position, mass, cell)
+
+struct TestRecord {
+    double x, y, z;
+    float  mass;
+    int    id;
+};
+H5WRAPPER_COMPOUND(TestRecord, x, y, z, mass, id)
 
 
 /*
@@ -42,9 +65,102 @@ TEST_CASE("H5Object constructors"){
     CHECK(lhs.is_valid() == false);
     CHECK(rhs.is_valid() == false);
 
+    //copies share the identifier, closing one leaves the other valid
+    auto space = H5Dataspace::create({3});
+    {
+        H5Dataspace copy(space);
+        CHECK(~copy == ~space);
+        CHECK(space.get_reference_count() == 2);
+        copy.close();
+        CHECK(~copy == 0);
+        CHECK(!copy.is_valid());
+    }
+    CHECK(space.is_valid());
+    CHECK(space.get_reference_count() == 1);
+
+    //moved from handles own nothing
+    H5Dataspace moved(std::move(space));
+    CHECK(~space == 0);
+    CHECK(moved.is_valid());
+
+    //a failure to close is reported by close() only, never by the destructor or an assignment
+    H5Dataspace closed = H5Dataspace::create({3});
+    H5Sclose(~closed);
+    CHECK_NOTHROW(closed = H5Dataspace::create({4}));
+    H5Sclose(~closed);
+    CHECK_THROWS(closed.close());
+    CHECK_NOTHROW([]() {
+        auto dangling = H5Dataspace::create({3});
+        H5Sclose(~dangling);
+    }());
+
 }
 
 
+TEST_CASE("Unique handles and views"){
+    using namespace H5Wrapper;
+
+    SECTION("move-only ownership"){
+        H5UniqueDataspace space(H5Screate_simple(1, std::array<hsize_t, 1>{4}.data(), nullptr));
+        hid_t id = ~space;
+        CHECK(bool(space));
+        CHECK(H5Iget_ref(id) == 1);
+
+        H5UniqueDataspace moved(std::move(space));
+        CHECK(!space);
+        CHECK(~moved == id);
+        CHECK(H5Iget_ref(id) == 1);
+
+        {
+            auto view = moved.view();
+            CHECK(view.is_borrowed());
+            CHECK(view.is_valid());
+            CHECK(view.get_dimensions() == std::vector<size_t>{4});
+            H5Dataspace copy(view);
+            CHECK(copy.is_borrowed());
+            CHECK(H5Iget_ref(id) == 1);
+        }
+        CHECK(H5Iis_valid(id) > 0);
+
+        moved.reset();
+        CHECK(H5Iis_valid(id) <= 0);
+    }
+
+    SECTION("adopting a reference counted handle"){
+        auto space = H5Dataspace::create({2, 3});
+        hid_t id = ~space;
+        H5UniqueDataspace unique(std::move(space));
+        CHECK(~unique == id);
+        CHECK(H5Iget_ref(id) == 1);
+
+        // owning copies made from a view take a new reference
+        H5Dataspace owned(unique.view().release());
+        CHECK(H5Iget_ref(id) == 2);
+        CHECK(!owned.is_borrowed());
+    }
+
+    SECTION("views in dataset calls"){
+        auto hf = H5File::create("unique_test1.h5", H5File::CreationFlag::TRUNCATE);
+        H5UniqueDataspace space(H5Dataspace::create({4}));
+        H5UniqueDatatype  type(H5DatatypeCreator<int>::create());
+        H5UniqueDataset   ds(H5Dataset::create(hf, "data", type.view(), space.view()));
+        H5UniqueProperty<H5DatasetTransferProperty> xfer(H5DatasetTransferProperty{});
+
+        std::vector<int> data{1, 2, 3, 4};
+        ds.view().write(data.data(), space.view(), space.view(), xfer.view());
+
+        std::vector<int> read(4);
+        auto view = ds.view();
+        view.read(read.data());
+        CHECK(read == data);
+
+        // the views of a dataset share its metadata, which is queried once
+        CHECK(&ds.view().cached_dataspace() == &view.cached_dataspace());
+        H5UniqueDataset moved(std::move(ds));
+        CHECK(&moved.view().cached_dataspace() == &view.cached_dataspace());
+    }
+}
+
 TEST_CASE("H5File creation") {
 
     using namespace H5Wrapper;
@@ -146,6 +262,144 @@ TEST_CASE("H5File functionality") {
 
 
 
+TEST_CASE("H5File MPI communicator and hints") {
+
+    using namespace H5Wrapper;
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    SECTION("H5MpiInfo"){
+        H5MpiInfo empty;
+        CHECK(empty.empty());
+        CHECK(~empty == MPI_INFO_NULL);
+        CHECK(empty.get("cb_nodes") == "");
+
+        H5MpiInfo hints{{"romio_cb_write", "enable"}};
+        hints.set("cb_buffer_size", "16777216");
+        CHECK(!hints.empty());
+        CHECK(hints.get("romio_cb_write") == "enable");
+        CHECK(hints.get("cb_buffer_size") == "16777216");
+        CHECK(hints.keys().size() == 2);
+
+        auto copy = hints;
+        CHECK(~copy == ~hints);
+    }
+
+    SECTION("the given access property is not modified"){
+        H5FileAccessProperty fapl;
+        hid_t driver = fapl.get_driver();
+        auto f = H5File::create(
+            "file_test_comm1.h5", H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+        CHECK(fapl.get_driver() == driver);
+        CHECK(f.get_access_property().is_valid());
+    }
+
+    SECTION("serial file while MPI is initialized"){
+        H5FileAccessProperty fapl;
+        fapl.set_serial();
+        CHECK(fapl.is_serial());
+        CHECK(fapl.copy().is_serial());
+
+        std::string fname = "file_test_serial_" + std::to_string(rank) + ".h5";
+        auto f =
+            H5File::create(fname, H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+        CHECK(f.get_access_property().get_driver() == H5FD_SEC2);
+        H5Group::create(f, "rank_" + std::to_string(rank));
+        f.close();
+
+        auto f2 = H5File::open(fname, H5File::AccessFlag::READ, fapl);
+        CHECK(H5Group::exists(f2, "rank_" + std::to_string(rank)));
+    }
+
+    SECTION("sub-communicator"){
+        MPI_Comm sub;
+        MPI_Comm_split(MPI_COMM_WORLD, rank % 2, rank, &sub);
+
+        H5MpiInfo hints;
+        hints.set("romio_cb_write", "enable");
+
+        std::string fname = "file_test_comm_" + std::to_string(rank % 2) + ".h5";
+        {
+            auto f = H5File::create(fname, H5File::CreationFlag::TRUNCATE, sub, hints);
+            H5Group::create(f, "group");
+        }
+        MPI_Barrier(sub);
+        {
+            auto f = H5File::open(fname, H5File::AccessFlag::READ, sub, hints);
+            CHECK(H5Group::exists(f, "group"));
+        }
+        MPI_Comm_free(&sub);
+    }
+}
+
+TEST_CASE("Collective metadata and transfer profiles") {
+
+    using namespace H5Wrapper;
+
+    SECTION("collective metadata"){
+        H5FileAccessProperty fapl;
+        fapl.set_collective_metadata();
+        CHECK(fapl.get_collective_metadata_reads());
+        CHECK(fapl.get_collective_metadata_writes());
+
+        fapl.set_collective_metadata(true, false);
+        CHECK(fapl.get_collective_metadata_reads());
+        CHECK(!fapl.get_collective_metadata_writes());
+
+        fapl.set_mpi(MPI_COMM_WORLD);
+        auto f = H5File::create(
+            "transfer_test1.h5", H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+        H5Group::create(f, "group");
+        CHECK(H5Group::exists(f, "group"));
+        CHECK(H5Group::open(f, "group").is_valid());
+    }
+
+    SECTION("transfer profiles"){
+        CHECK(H5DatasetTransferProperty().get_mpi_io_mode() == H5FD_MPIO_INDEPENDENT);
+        CHECK(H5DatasetTransferProperty::independent().get_mpi_io_mode() == H5FD_MPIO_INDEPENDENT);
+        CHECK(H5DatasetTransferProperty::collective().get_mpi_io_mode() == H5FD_MPIO_COLLECTIVE);
+        CHECK(H5DatasetTransferProperty::collective_chunked().get_mpi_io_mode() ==
+              H5FD_MPIO_COLLECTIVE);
+        CHECK(!H5DatasetTransferProperty::collective().collective_required());
+        CHECK(H5DatasetTransferProperty::collective_checked().collective_required());
+        H5UniqueProperty<H5DatasetTransferProperty> adopted(
+            H5DatasetTransferProperty::collective_checked());
+        CHECK(adopted.view().collective_required());
+        CHECK(H5DatasetTransferProperty(H5Pcopy(~adopted)).collective_required());
+        CHECK(!H5DatasetTransferProperty(H5Pcreate(H5P_DATASET_XFER)).collective_required());
+
+        CHECK(H5DatasetTransferProperty::describe_no_collective_cause(H5D_MPIO_COLLECTIVE) ==
+              "collective");
+        CHECK(H5DatasetTransferProperty::describe_no_collective_cause(
+                  H5D_MPIO_SET_INDEPENDENT | H5D_MPIO_DATATYPE_CONVERSION) ==
+              "independent I/O was requested, datatype conversion");
+    }
+
+    SECTION("actual io mode"){
+        int rank, size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+        auto f = H5File::create("transfer_test2.h5", H5File::CreationFlag::TRUNCATE);
+        auto file_space = H5Dataspace::create({size_t(size) * 4});
+        auto ds = H5Dataset::create(f, "data", H5DatatypeCreator<int>::create(), file_space);
+        auto slab = H5Hyperslab::select(file_space, {size_t(rank) * 4}, {4});
+        auto memory_space = H5Dataspace::create({4});
+        std::vector<int> data(4, rank);
+
+        auto independent = H5DatasetTransferProperty::independent();
+        ds.write(data.data(), memory_space, slab, independent);
+        CHECK(!independent.collective_io_performed());
+        CHECK((independent.get_no_collective_cause().first & H5D_MPIO_SET_INDEPENDENT));
+
+        auto checked = H5DatasetTransferProperty::collective_checked();
+        REQUIRE_NOTHROW(ds.write(data.data(), memory_space, slab, checked));
+        CHECK(checked.collective_io_performed());
+        CHECK(checked.get_no_collective_cause().first == H5D_MPIO_COLLECTIVE);
+    }
+}
+
 TEST_CASE("Group tests") {
 
     using namespace H5Wrapper;
@@ -187,6 +441,66 @@ TEST_CASE("Group tests") {
 
     }
 
+    SECTION("path index"){
+
+        CHECK(detail::join_path("/", "a//b/./c/") == "/a/b/c");
+        CHECK(detail::join_path("/a", "b") == "/a/b");
+        CHECK(detail::join_path("/a", "/b") == "/b");
+        CHECK(detail::join_path("/", "") == "/");
+
+        std::string long_path;
+        for (size_t i = 0; i < 300; ++i) { long_path += "level_" + std::to_string(i) + "/"; }
+        H5Group::create(hf, long_path);
+        CHECK(H5Group::exists(hf, long_path));
+        CHECK(H5Group::exists(hf, long_path + "missing") == false);
+
+        hf.enable_path_index();
+        REQUIRE(hf.path_index());
+        CHECK(hf.path_index()->size() == 0);
+
+        auto g = H5Group::create(hf, "indexed/a");
+        CHECK(g.path_index() == hf.path_index());
+        CHECK(hf.path_index()->contains("/indexed"));
+        CHECK(hf.path_index()->type("/indexed/a") == H5O_TYPE_GROUP);
+
+        auto ds =
+            H5Dataset::create(g, "ds", H5DatatypeCreator<int>::create(), H5Dataspace::create({1}));
+        CHECK(hf.path_index()->type("/indexed/a/ds") == H5O_TYPE_DATASET);
+        CHECK_THROWS_WITH(H5Group::open(g, "ds"), "H5Group open fails. Not a group.");
+
+        CHECK(H5Group::exists(hf, "indexed/a/ds"));
+        CHECK(H5Group::exists(g, "ds"));
+        CHECK(H5Group::exists(g, "/indexed"));
+        CHECK(H5Group::exists(hf, "indexed/b") == false);
+
+        // created outside of the wrapper, found in the file and then cached
+        H5Gclose(H5Gcreate(~g, "raw", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+        CHECK(hf.path_index()->contains("/indexed/a/raw") == false);
+        CHECK(H5Group::exists(g, "raw"));
+        CHECK(hf.path_index()->contains("/indexed/a/raw"));
+
+        auto opened = H5Group::open(g, "raw");
+        CHECK(opened.path_index() == hf.path_index());
+        CHECK(opened.absolute_path("x") == "/indexed/a/raw/x");
+
+        // repeated opens share the group kept open by the index
+        CHECK(~H5Group::open(g, "raw") == ~opened);
+        CHECK(~H5Group::open(hf, "/indexed/a/raw") == ~opened);
+        CHECK(~H5Group::open(g, "raw", H5GroupAccessProperty()) != ~opened);
+
+        // a removed link is erased from the index along with the group kept open
+        H5Group::create(g, "doomed/child");
+        CHECK(hf.path_index()->cached_group("/indexed/a/doomed/child") > 0);
+        g.remove_link("doomed");
+        CHECK(hf.path_index()->contains("/indexed/a/doomed") == false);
+        CHECK(hf.path_index()->contains("/indexed/a/doomed/child") == false);
+        CHECK(H5Group::exists(g, "doomed") == false);
+
+        hf.path_index()->erase("/indexed/a");
+        CHECK(hf.path_index()->contains("/indexed/a/ds") == false);
+        CHECK(hf.path_index()->contains("/indexed"));
+    }
+
     SECTION("link_names/dataset_names"){
 
         auto link_group = H5Group::create(hf, "link_names_test");
@@ -199,6 +513,50 @@ TEST_CASE("Group tests") {
 
         CHECK(link_group.link_names() == std::vector<std::string>{"obj1", "obj2", "obj3", "other_group"});
         CHECK(link_group.dataset_names() == std::vector<std::string>{"obj1", "obj2", "obj3"});
+
+        H5Lcreate_soft("obj1", ~link_group, "soft", H5P_DEFAULT, H5P_DEFAULT);
+        auto infos = link_group.link_infos();
+        REQUIRE(infos.size() == 5);
+        CHECK(infos[0].name == "obj1");
+        CHECK(infos[0].type == H5L_TYPE_HARD);
+        CHECK(infos[4].name == "soft");
+        CHECK(infos[4].type == H5L_TYPE_SOFT);
+
+        size_t count = 0;
+        link_group.for_each_link([&count](const char*, H5L_type_t) { ++count; });
+        CHECK(count == link_group.nlinks());
+
+        auto stop = [](const char*, H5L_type_t) { throw std::logic_error("stop"); };
+        CHECK_THROWS_AS(link_group.for_each_link(stop), std::logic_error);
+    }
+
+    SECTION("group_names/datatype_names"){
+
+        auto root = H5Group::create(hf, "object_names_test");
+        auto datatype = H5DatatypeCreator<double>::create();
+        auto dataspace = H5Dataspace::create({2});
+        H5Dataset::create(root, "ds", datatype, dataspace);
+        auto sub = H5Group::create(root, "sub");
+        H5Dataset::create(sub, "nested", datatype, dataspace);
+        H5Tcommit2(
+            ~root, "dtype", ~H5Datatype::copy(datatype), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        H5Lcreate_soft("ds", ~root, "soft_ds", H5P_DEFAULT, H5P_DEFAULT);
+        H5Lcreate_soft("missing", ~root, "dangling", H5P_DEFAULT, H5P_DEFAULT);
+
+        CHECK(root.dataset_names() == std::vector<std::string>{"ds", "soft_ds"});
+        CHECK(root.group_names() == std::vector<std::string>{"sub"});
+        CHECK(root.datatype_names() == std::vector<std::string>{"dtype"});
+
+        CHECK(root.dataset_names(true) == std::vector<std::string>{"ds", "sub/nested"});
+        CHECK(root.group_names(true) == std::vector<std::string>{"sub"});
+
+        size_t count = 0;
+        root.for_each_object([&count](const char*, H5O_type_t) { ++count; });
+        CHECK(count == 4);
+
+        auto stop = [](const char*, H5O_type_t) { throw std::logic_error("stop"); };
+        CHECK_THROWS_AS(root.for_each_object(stop), std::logic_error);
+        CHECK_THROWS_AS(root.for_each_object(stop, true), std::logic_error);
     }
 
 }
@@ -237,6 +595,119 @@ TEST_CASE("H5DatatypeCreator create") {
 
 
 
+TEST_CASE("Compound datatypes from structs") {
+
+    using namespace H5Wrapper;
+
+    auto dt = H5DatatypeCreator<TestParticle>::create();
+    CHECK(dt.get_size() == sizeof(TestParticle));
+    CHECK(dt.get_nmembers() == 4);
+    CHECK(dt.get_member_name(1) == "position");
+    CHECK(dt.get_member_offset(2) == offsetof(TestParticle, mass));
+    CHECK(dt.get_member_class(1) == H5T_ARRAY);
+    CHECK(dt.get_member_class(3) == H5T_COMPOUND);
+
+    auto packed = H5DatatypeCreator<TestParticle>::create_packed();
+    CHECK(packed.get_size() < sizeof(TestParticle));
+    CHECK(H5DatatypeCompound::same_members(~dt, ~packed));
+    CHECK_FALSE(H5DatatypeCompound::same_members(~dt, ~H5DatatypeCreator<TestCell>::create()));
+
+    std::vector<TestParticle> particles(3);
+    for (size_t i = 0; i < particles.size(); ++i) {
+        particles[i] = TestParticle{int(i), {double(i), 2.0, 3.0}, float(i), {i, {0.5, 0.25}}};
+    }
+
+    auto hf = H5File::create("compound_test.h5", H5File::CreationFlag::TRUNCATE);
+
+    SECTION("native layout"){
+        auto ds = H5Dataset::create(hf, "native", dt, H5Dataspace::create({3}));
+        ds.write(particles);
+
+        std::vector<TestParticle> read(3);
+        ds.read(read);
+        CHECK(read[2].position[0] == 2.0);
+        CHECK(read[2].cell.index == 2);
+        CHECK(read[1].cell.weights[1] == 0.25);
+    }
+
+    SECTION("packed file layout"){
+        auto ds = H5Dataset::create(hf, "packed", packed, H5Dataspace::create({3}));
+        ds.write(particles);
+
+        std::vector<TestParticle> read(3);
+        ds.read(read);
+        CHECK(read[2].mass == 2.0f);
+        CHECK(read[2].id == 2);
+        CHECK(read[2].cell.weights[0] == 0.5);
+    }
+
+}
+
+TEST_CASE("Compound columns") {
+
+    using namespace H5Wrapper;
+
+    const size_t n = 5;
+    std::vector<double> x(n), y(n), z(n);
+    std::vector<float>  mass(n, 1.0f);
+    std::vector<int>    id(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i]  = double(i);
+        y[i]  = 10.0 + double(i);
+        z[i]  = 20.0 + double(i);
+        id[i] = int(i);
+    }
+
+    auto hf = H5File::create("columns_test.h5", H5File::CreationFlag::TRUNCATE);
+    auto ds = H5Dataset::create(hf,
+                                "particles",
+                                H5DatatypeCreator<TestRecord>::create_packed(),
+                                H5Dataspace::create({n}));
+
+    ds.write_columns({H5Column("x", x),
+                      H5Column("y", y),
+                      H5Column("z", z),
+                      H5Column("mass", mass),
+                      H5Column("id", id)});
+
+    SECTION("subset of the members"){
+        std::vector<double> rx(n), rz(n);
+        ds.read_columns({H5Column("x", rx), H5Column("z", rz)});
+        CHECK(rx == x);
+        CHECK(rz == z);
+
+        CHECK(ds.read_column<int>("id") == id);
+        CHECK(ds.read_column<double>("mass")[3] == 1.0);
+    }
+
+    SECTION("single member update keeps the others"){
+        const std::vector<float> heavy(n, 2.0f);
+        ds.write_columns({H5Column("mass", heavy)});
+        CHECK(ds.read_column<float>("mass") == heavy);
+        CHECK(ds.read_column<double>("y") == y);
+    }
+
+    SECTION("selection"){
+        std::vector<int> ids(2);
+        auto slab = H5Hyperslab::select(ds.cached_dataspace(), {2}, {2});
+        ds.read_columns({H5Column("id", ids)}, slab);
+        CHECK(ids == std::vector<int>{2, 3});
+
+        std::vector<double> short_column(2);
+        CHECK_THROWS(ds.read_columns({H5Column("x", short_column)}));
+        const std::vector<double> read_only(n);
+        CHECK_THROWS(ds.read_columns({H5Column("x", read_only)}));
+    }
+
+    SECTION("records read back as structs"){
+        std::vector<TestRecord> records(n);
+        ds.read(records);
+        CHECK(records[4].y == 14.0);
+        CHECK(records[4].id == 4);
+    }
+
+}
+
 TEST_CASE("H5Datatype test") {
 
     using namespace H5Wrapper;
@@ -313,6 +784,8 @@ TEST_CASE("H5Dataspace creation"){
 
     auto ds2 = H5DataspaceAll();
     auto ds3 = H5DataspaceScalar();
+    CHECK(ds3.is_valid());
+    CHECK(ds3.get_rank() == 0);
 
     //CHECK(ds2.is_valid()); //TODO: It appears that H5S_ALL is not valid... WTF??
 
@@ -451,6 +924,91 @@ TEST_CASE("H5Dataset read and write all"){
 
 
 
+}
+
+TEST_CASE("H5Dataset cached metadata"){
+
+    using namespace H5Wrapper;
+
+
+    std::string fname = "dataset_test6.h5";
+    std::string dsetname1 = "first";
+
+    std::vector<size_t> buffer_dims{10};
+
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+    auto dt = H5DatatypeCreator<int>::create();
+    auto file_dataspace = H5Dataspace::create(buffer_dims);
+
+    auto ds1 = H5Dataset::create(hf, dsetname1, dt, file_dataspace);
+
+    CHECK(ds1.cached_dataspace().get_dimensions() == buffer_dims);
+    CHECK(ds1.cached_datatype().get_class() == H5T_INTEGER);
+
+    std::vector<int> buffer(10);
+    for (int i = 0; i < 5; ++i){
+        std::fill(buffer.begin(), buffer.end(), i);
+        ds1.write(buffer.data());
+    }
+
+    std::vector<int> read_buffer(10, -1);
+    ds1.read(read_buffer.data());
+    CHECK(read_buffer == buffer);
+
+    ds1.refresh_metadata();
+    CHECK(ds1.cached_dataspace().get_dimensions() == buffer_dims);
+
+    ds1.close();
+    CHECK(!ds1.cached_dataspace().is_valid());
+
+}
+
+TEST_CASE("H5Dataset typed read and write"){
+
+    using namespace H5Wrapper;
+
+
+    std::string fname = "dataset_test7.h5";
+
+    std::vector<size_t> buffer_dims{10};
+
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+    auto file_dataspace = H5Dataspace::create(buffer_dims);
+    auto ds1 = H5Dataset::create(hf, "float", H5DatatypeCreator<float>::create(), file_dataspace);
+
+    std::vector<float> fbuffer(10, 1.5f);
+    ds1.write(fbuffer.data());
+
+    SECTION("matching types"){
+        std::vector<float> read_buffer(10, 0.f);
+        ds1.read(read_buffer.data());
+        CHECK(read_buffer == fbuffer);
+
+        // repeated calls use the already verified memory type
+        ds1.read(read_buffer.data());
+        CHECK(read_buffer == fbuffer);
+    }
+
+    SECTION("mismatching types require conversion"){
+        std::vector<double> dbuffer(10, 0.0);
+        REQUIRE_THROWS(ds1.read(dbuffer.data()));
+
+        H5DatasetTransferProperty transfer;
+        CHECK(!transfer.type_conversion_allowed());
+        transfer.allow_type_conversion(1024);
+        CHECK(transfer.type_conversion_allowed());
+        CHECK(transfer.get_conversion_buffer_size() == 1024);
+        CHECK(H5DatasetTransferProperty(~transfer, H5Object::borrowed).type_conversion_allowed());
+
+        ds1.read(dbuffer.data(), H5DataspaceAll(), transfer);
+        CHECK(dbuffer == std::vector<double>(10, 1.5));
+
+        std::vector<int> ibuffer(10, 3);
+        ds1.write(ibuffer.data(), H5DataspaceAll(), transfer);
+        ds1.read(fbuffer.data());
+        CHECK(fbuffer == std::vector<float>(10, 3.f));
+    }
+
 }
 
 TEST_CASE("H5Dataset read and write hyperslab"){
@@ -622,6 +1180,216 @@ TEST_CASE("H5Dataset write hyperslab hyperslab"){
 
 
 
+TEST_CASE("H5DistributedArray"){
+
+    using namespace H5Wrapper;
+
+    // blocks of 4 x 6 stacked along the first axis, 1 x 2 ghost layers
+    const size_t ranks = mpi_process_count();
+    const size_t rank  = mpi_process_rank();
+    const std::array<size_t, 2> global{4 * ranks, 6}, offset{4 * rank, 0};
+    const std::array<size_t, 2> extent{4, 6}, ghost{1, 2};
+
+    SECTION("write and read fields"){
+        H5DistributedArray<int, 2> array(global, offset, extent, ghost);
+        CHECK(array.local_dims() == std::array<size_t, 2>{6, 10});
+        CHECK(array.local_size() == 60);
+
+        std::vector<int> field(array.local_size(), -1);
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = 0; j < 6; ++j) {
+                field[(i + 1) * 10 + j + 2] = int((offset[0] + i) * 6 + j);
+            }
+        }
+
+        {
+            auto hf = H5File::create("distributed_array_test.h5", H5File::CreationFlag::TRUNCATE);
+            array.write(hf, "pressure", field);
+            auto ds = array.create_dataset(hf, "density");
+            array.write(ds, field.data());
+        }
+
+        auto hf = H5File::open("distributed_array_test.h5", H5File::AccessFlag::READ);
+
+        std::vector<int> global_field(4 * ranks * 6), expected(4 * ranks * 6);
+        H5Dataset::open(hf, "density").read(global_field.data());
+        for (size_t i = 0; i < expected.size(); ++i) { expected[i] = int(i); }
+        CHECK(global_field == expected);
+
+        std::vector<int> local(array.local_size(), -1);
+        array.read(hf, "pressure", local);
+        CHECK(local == field);
+    }
+
+    SECTION("invalid decompositions"){
+        using Array = H5DistributedArray<int, 2>;
+        CHECK_THROWS(Array({4 * ranks + 1, 6}, offset, extent, ghost));
+        CHECK_THROWS(Array(global, {4 * rank, 1}, extent, ghost));
+        // every rank claims the first block
+        if (ranks > 1) {
+            CHECK_THROWS(Array(global, {0, 0}, extent, ghost));
+            const std::array<size_t, 2> differing{global[0], rank == 0 ? global[1] : global[1] + 1};
+            CHECK_THROWS_WITH(Array(differing, offset, extent, ghost),
+                              "H5DistributedArray global dimensions differ between ranks.");
+        }
+    }
+
+}
+
+TEST_CASE("H5Dataset memory views"){
+
+    using namespace H5Wrapper;
+
+    std::string fname = "dataset_test_views.h5";
+
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+    auto dt = H5DatatypeCreator<int>::create();
+
+    SECTION("containers"){
+        auto ds = H5Dataset::create(hf, "vector", dt, H5Dataspace::create({2, 3}));
+
+        std::vector<int> data = {1, 2, 3, 4, 5, 6};
+        ds.write(data);
+
+        std::array<int, 6> read{};
+        ds.read(read);
+        CHECK(read[5] == 6);
+
+        std::vector<int> too_small(5);
+        CHECK_THROWS(ds.read(too_small));
+
+        std::vector<int> row(3, 0);
+        auto slab = H5Hyperslab::select(ds.cached_dataspace(), {1, 0}, {1, 3});
+        ds.read(row, slab);
+        CHECK(row == std::vector<int>{4, 5, 6});
+    }
+
+    SECTION("ghost cell padded block"){
+        // same layout as the "hyperslab hyperslab" test: 5x5 interior with 2 ghost cells
+        const std::vector<size_t> local_dims = {9, 9};
+        std::vector<int>          buffer(81, 1);
+
+        auto file_space = H5Dataspace::create({10, 10});
+        auto ds         = H5Dataset::create(hf, "padded", dt, file_space);
+        auto file_slab  = H5Hyperslab::select(file_space, {0, 5}, {5, 5});
+
+        ds.write(H5MemoryView<const int>::block(buffer.data(), local_dims, {2, 2}, {5, 5}),
+                 file_slab);
+
+        std::vector<int> read(81, 2);
+        auto interior = H5MemoryView<int>::block(read.data(), local_dims, {2, 2}, {5, 5});
+        ds.read(interior, file_slab);
+        ds.read(interior, file_slab);
+
+        CHECK(read[2 * 9 + 2] == 1);
+        CHECK(read[6 * 9 + 6] == 1);
+        CHECK(read[0] == 2);
+        CHECK(read[7 * 9 + 7] == 2);
+    }
+
+    SECTION("strided columns"){
+        // every second value of the rows of a 3x8 array
+        std::vector<int> data(24);
+        for (size_t i = 0; i < data.size(); ++i) { data[i] = int(i); }
+
+        auto ds = H5Dataset::create(hf, "strided", dt, H5Dataspace::create({3, 4}));
+        ds.write(H5MemoryView<const int>(data.data(), {3, 4}, {8, 2}));
+
+        std::vector<int> read(12);
+        ds.read(read);
+        CHECK(read == std::vector<int>{0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22});
+
+        CHECK_THROWS(H5MemoryView<int>(data.data(), {3, 5}, {8, 2}));
+    }
+
+    SECTION("memory dataspaces are cached per shape"){
+        auto ds = H5Dataset::create(hf, "cached", dt, H5Dataspace::create({4}));
+
+        std::vector<int> a(4, 1), b(4, 2);
+        H5MemoryView<int> va(a.data(), {4});
+        H5MemoryView<int> vb(b.data(), {4});
+        CHECK(~ds.memory_dataspace(va) == ~ds.memory_dataspace(vb));
+
+        H5MemoryView<int> strided(a.data(), {2}, {2});
+        CHECK(~ds.memory_dataspace(strided) != ~ds.memory_dataspace(va));
+    }
+
+}
+
+TEST_CASE("H5Dataset read into new buffers"){
+
+    using namespace H5Wrapper;
+
+    std::string fname = "dataset_test_buffers.h5";
+
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+
+    std::vector<double> data(12);
+    for (size_t i = 0; i < data.size(); ++i) { data[i] = double(i); }
+
+    auto ds = H5Dataset::create(
+        hf, "field", H5DatatypeCreator<double>::create(), H5Dataspace::create({3, 4}));
+    ds.write(data);
+
+    SECTION("read_all"){
+        auto buffer = ds.read_all<double>();
+        CHECK(buffer.dims() == std::vector<size_t>{3, 4});
+        CHECK(buffer.size() == 12);
+        CHECK(buffer[11] == 11.0);
+        CHECK(reinterpret_cast<std::uintptr_t>(buffer.data()) % H5Buffer<double>::alignment == 0);
+
+        std::vector<double, H5AlignedAllocator<double>> aligned;
+        ds.read_all(aligned);
+        CHECK(aligned.size() == 12);
+        CHECK(aligned[5] == 5.0);
+        CHECK(reinterpret_cast<std::uintptr_t>(aligned.data()) % 64 == 0);
+    }
+
+    SECTION("read_slab"){
+        auto slab = ds.read_slab<double>({1, 1}, {2, 2});
+        CHECK(slab.dims() == std::vector<size_t>{2, 2});
+        CHECK(slab[0] == 5.0);
+        CHECK(slab[3] == 10.0);
+    }
+
+    SECTION("pooled buffers are reused"){
+        H5BufferPool pool;
+        const double* first;
+        {
+            auto buffer = ds.read_all<double>(pool);
+            first       = buffer.data();
+            CHECK(pool.cached_bytes() == 0);
+        }
+        CHECK(pool.cached_bytes() > 0);
+
+        auto again = ds.read_all<double>(pool);
+        CHECK(again.data() == first);
+        CHECK(again[7] == 7.0);
+        CHECK(pool.cached_bytes() == 0);
+
+        // the buffer outlives a moved from handle
+        H5Buffer<double> moved = std::move(again);
+        CHECK(moved.data() == first);
+
+        auto other = ds.read_slab<double>({0, 0}, {1, 4}, pool);
+        CHECK(other.data() != first);
+        CHECK(other[3] == 3.0);
+
+        pool.clear();
+        CHECK(pool.cached_bytes() == 0);
+    }
+
+    SECTION("pool keeps at most max_cached_bytes"){
+        H5BufferPool pool(H5Buffer<double>::alignment);
+        CHECK(pool.max_cached_bytes() == H5Buffer<double>::alignment);
+        { auto small = ds.read_slab<double>({0, 0}, {1, 4}, pool); }
+        CHECK(pool.cached_bytes() == H5Buffer<double>::alignment);
+        { auto large = ds.read_all<double>(pool); }
+        CHECK(pool.cached_bytes() == H5Buffer<double>::alignment);
+    }
+
+}
+
 TEST_CASE("H5Dataset read and write unstructured"){
 
     using namespace H5Wrapper;
@@ -696,6 +1464,621 @@ TEST_CASE("H5Dataset read and write unstructured"){
 
 }
 
+TEST_CASE("Attributes"){
+
+    using namespace H5Wrapper;
+
+    std::string fname = "attribute_test.h5";
+
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+    auto group = H5Group::create(hf, "step_0");
+
+    SECTION("scalars, strings and vectors"){
+        group.set_attribute("time", 1.5);
+        group.set_attribute("iteration", 42);
+        group.set_attribute("solver", std::string("rk4"));
+        group.set_attribute("origin", std::vector<double>{0.0, 1.0, 2.0});
+
+        CHECK(group.has_attribute("time"));
+        CHECK_FALSE(group.has_attribute("dt"));
+        CHECK(group.get_attribute<double>("time") == 1.5);
+        CHECK(group.get_attribute<int>("iteration") == 42);
+        CHECK(group.get_attribute<std::string>("solver") == "rk4");
+        CHECK(group.get_attribute<std::vector<double>>("origin") ==
+              std::vector<double>{0.0, 1.0, 2.0});
+        CHECK(group.attribute_names() ==
+              std::vector<std::string>{"iteration", "origin", "solver", "time"});
+
+        CHECK_THROWS(group.get_attribute<double>("origin"));
+    }
+
+    SECTION("overwrite"){
+        group.set_attribute("time", 1.0);
+        group.set_attribute("time", 2.0);
+        CHECK(group.get_attribute<double>("time") == 2.0);
+
+        group.set_attribute("time", std::string("late"));
+        CHECK(group.get_attribute<std::string>("time") == "late");
+
+        group.remove_attribute("time");
+        CHECK_FALSE(group.has_attribute("time"));
+    }
+
+    SECTION("batched"){
+        std::map<std::string, double> step = {{"time", 0.5}, {"dt", 0.01}, {"cfl", 0.9}};
+        group.set_attributes(step);
+        group.set_attributes(std::map<std::string, double>{{"time", 0.51}});
+        CHECK(group.get_attribute<double>("time") == 0.51);
+        CHECK(group.get_attribute<double>("dt") == 0.01);
+        CHECK(group.attribute_names().size() == 3);
+    }
+
+    SECTION("datasets and files"){
+        auto ds = H5Dataset::create(
+            hf, "field", H5DatatypeCreator<float>::create(), H5Dataspace::create({4}));
+        ds.set_attribute("units", "m/s");
+        CHECK(ds.get_attribute<std::string>("units") == "m/s");
+
+        // variable length strings, as written e.g. by h5py
+        hid_t       vlen  = H5Tcopy(H5T_C_S1);
+        hid_t       space = H5Screate(H5S_SCALAR);
+        const char* text  = "second order upwind";
+        H5Tset_size(vlen, H5T_VARIABLE);
+        hid_t attr = H5Acreate2(~ds, "scheme", vlen, space, H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, vlen, &text);
+        H5Aclose(attr);
+        H5Sclose(space);
+        H5Tclose(vlen);
+        CHECK(ds.get_attribute<std::string>("scheme") == "second order upwind");
+
+        ds.set_attribute("count", 4);
+        CHECK_THROWS(ds.get_attribute<std::string>("count"));
+
+        hf.set_attribute("version", 3u);
+        CHECK(hf.get_attribute<unsigned>("version") == 3u);
+        CHECK(H5Group::open(hf, "/").has_attribute("version"));
+    }
+
+    SECTION("dense storage"){
+        H5GroupCreateProperty gcpl;
+        gcpl.set_dense_attributes();
+        CHECK(gcpl.get_attribute_phase_change() == std::pair<unsigned, unsigned>{0, 0});
+
+        auto dense = H5Group::create(hf, "dense", true, gcpl);
+        std::map<std::string, int> values;
+        for (int i = 0; i < 100; ++i) { values["attr_" + std::to_string(i)] = i; }
+        dense.set_attributes(values);
+
+        CHECK(dense.attribute_names().size() == 100);
+        CHECK(dense.get_attribute<int>("attr_57") == 57);
+    }
+
+}
+
+TEST_CASE("H5DatasetCreateProperty chunking and filters"){
+
+    using namespace H5Wrapper;
+
+    SECTION("guess_chunk"){
+        auto chunk = H5DatasetCreateProperty::guess_chunk({1000, 1000, 100}, sizeof(double));
+        REQUIRE(chunk.size() == 3);
+        CHECK(chunk[0] <= 1000);
+        CHECK(chunk[1] <= 1000);
+        CHECK(chunk[2] <= 100);
+        CHECK(chunk[0] * chunk[1] * chunk[2] * sizeof(double) <= 1024 * 1024);
+
+        CHECK(H5DatasetCreateProperty::guess_chunk({10}, sizeof(int)) == std::vector<size_t>{10});
+        CHECK(H5DatasetCreateProperty::guess_chunk({0}, sizeof(int)).at(0) > 0);
+    }
+
+    SECTION("chunked and compressed dataset"){
+
+        std::string fname = "dataset_test8.h5";
+        std::vector<size_t> dims{40, 50};
+
+        auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+        auto file_dataspace = H5Dataspace::create(dims);
+
+        H5DatasetCreateProperty dcpl;
+        CHECK(dcpl.get_layout() == H5D_CONTIGUOUS);
+        CHECK(dcpl.get_chunk().empty());
+
+        dcpl.set_chunk({10, 25});
+        dcpl.set_shuffle();
+        dcpl.set_fletcher32();
+        if (H5DatasetCreateProperty::filter_available(H5Z_FILTER_DEFLATE)) {
+            dcpl.set_deflate(4);
+            CHECK(dcpl.get_nfilters() == 3);
+        }
+
+        CHECK(dcpl.get_layout() == H5D_CHUNKED);
+        CHECK(dcpl.get_chunk() == std::vector<size_t>{10, 25});
+
+        auto ds1 = H5Dataset::create(hf,
+                                     "compressed",
+                                     H5DatatypeCreator<float>::create(),
+                                     file_dataspace,
+                                     H5LinkCreateProperty(),
+                                     dcpl);
+
+        std::vector<float> buffer(dims[0] * dims[1]);
+        for (size_t i = 0; i < buffer.size(); ++i) { buffer[i] = float(i % 7); }
+        ds1.write(buffer.data());
+
+        std::vector<float> read_buffer(buffer.size(), -1.f);
+        ds1.read(read_buffer.data());
+        CHECK(read_buffer == buffer);
+
+        auto stored = ds1.get_create_property();
+        CHECK(stored.get_chunk() == std::vector<size_t>{10, 25});
+        CHECK(stored.get_nfilters() == dcpl.get_nfilters());
+
+        H5DatasetCreateProperty scaled;
+        scaled.set_auto_chunk(file_dataspace, sizeof(float));
+        scaled.set_scaleoffset(H5Z_SO_FLOAT_DSCALE, 2);
+        CHECK(scaled.get_layout() == H5D_CHUNKED);
+        auto ds2 = H5Dataset::create(hf,
+                                     "scaled",
+                                     H5DatatypeCreator<float>::create(),
+                                     file_dataspace,
+                                     H5LinkCreateProperty(),
+                                     scaled);
+        ds2.write(buffer.data());
+        ds2.read(read_buffer.data());
+        CHECK(read_buffer == buffer);
+    }
+
+}
+
+TEST_CASE("Extendible datasets"){
+
+    using namespace H5Wrapper;
+
+    std::string fname = "dataset_test9.h5";
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE);
+
+    SECTION("unlimited dataspace and set_extent"){
+
+        auto space = H5Dataspace::create({2, 3}, {H5Dataspace::unlimited, 3});
+        CHECK(space.get_dimensions() == std::vector<size_t>{2, 3});
+        CHECK(space.get_max_dimensions() == std::vector<size_t>{H5Dataspace::unlimited, 3});
+
+        H5DatasetCreateProperty dcpl;
+        dcpl.set_chunk({4, 3});
+        auto ds1 = H5Dataset::create(hf,
+                                     "extendible",
+                                     H5DatatypeCreator<int>::create(),
+                                     space,
+                                     H5LinkCreateProperty(),
+                                     dcpl);
+
+        auto copy = ds1;
+        ds1.set_extent({5, 3});
+        CHECK(ds1.cached_dataspace().get_dimensions() == std::vector<size_t>{5, 3});
+        CHECK(ds1.get_dataspace().get_dimensions() == std::vector<size_t>{5, 3});
+        CHECK(copy.cached_dataspace().get_dimensions() == std::vector<size_t>{5, 3});
+
+        ds1.extend({2, 0});
+        CHECK(ds1.cached_dataspace().get_dimensions() == std::vector<size_t>{7, 3});
+
+        std::vector<int> buffer(7 * 3, 4);
+        ds1.write(buffer.data());
+        std::vector<int> read_buffer(7 * 3, 0);
+        ds1.read(read_buffer.data());
+        CHECK(read_buffer == buffer);
+    }
+
+    SECTION("H5AppendStream"){
+
+        {
+            auto stream = H5AppendStream<double>::create(hf, "series", {}, 64);
+            CHECK(stream.buffer_rows() == 64);
+            CHECK(stream.row_size() == 1);
+            for (size_t i = 0; i < 1000; ++i) { stream.append(double(i)); }
+            CHECK(stream.size() == 1000);
+        }
+
+        auto ds1 = H5Dataset::open(hf, "series");
+        CHECK(ds1.get_dataspace().get_dimensions() == std::vector<size_t>{1000});
+
+        std::vector<double> values(1000);
+        ds1.read(values.data());
+        CHECK(values[0] == 0.0);
+        CHECK(values[999] == 999.0);
+
+        {
+            auto stream = H5AppendStream<int>::create(hf, "rows", {3}, 4);
+            std::vector<int> rows{1, 2, 3, 4, 5, 6};
+            stream.append(rows.data(), 2);
+            stream.close();
+
+            auto appender = H5AppendStream<int>::open(hf, "rows");
+            CHECK(appender.size() == 2);
+            appender.append(rows.data());
+        }
+
+        auto ds2 = H5Dataset::open(hf, "rows");
+        CHECK(ds2.get_dataspace().get_dimensions() == std::vector<size_t>{3, 3});
+        std::vector<int> read_rows(9);
+        ds2.read(read_rows.data());
+        CHECK(read_rows == std::vector<int>{1, 2, 3, 4, 5, 6, 1, 2, 3});
+
+        // a read-only file can not be extended: close() throws, the destructor does not
+        auto             read_only = H5File::from_image(hf.to_image());
+        std::vector<int> row{7, 8, 9};
+        {
+            auto appender = H5AppendStream<int>::open(read_only, "rows");
+            appender.append(row.data());
+            CHECK_THROWS(appender.close());
+        }
+        CHECK_NOTHROW([&]() {
+            auto appender = H5AppendStream<int>::open(read_only, "rows");
+            appender.append(row.data());
+        }());
+    }
+
+}
+
+TEST_CASE("Chunk cache"){
+
+    using namespace H5Wrapper;
+
+    SECTION("access patterns"){
+        const std::vector<size_t> dims{16, 32, 32}, chunk{8, 8, 8};
+        CHECK(H5AccessPattern::planes(0).selection(dims) == std::vector<size_t>{1, 32, 32});
+        CHECK(H5AccessPattern::planes(0).chunks_per_selection(dims, chunk) == 16);
+        CHECK(H5AccessPattern::planes(2, 4).chunks_per_selection(dims, chunk) == 8);
+        CHECK(H5AccessPattern::planes(2, 3).chunks_per_selection(dims, chunk) == 16);
+        CHECK(H5AccessPattern::blocks({8, 8, 8}).chunks_per_selection(dims, chunk) == 8);
+        CHECK(H5AccessPattern::blocks({1, 1, 1}).chunks_per_selection(dims, chunk) == 1);
+    }
+
+    SECTION("access property"){
+        H5DatasetAccessProperty dapl;
+        dapl.set_chunk_cache(1009, 4 << 20, 0.5);
+        CHECK(dapl.get_chunk_cache_slots() == 1009);
+        CHECK(dapl.get_chunk_cache_bytes() == size_t(4 << 20));
+        CHECK(dapl.get_chunk_cache_preemption() == 0.5);
+    }
+
+    SECTION("adaptive open"){
+        auto hf = H5File::create("chunk_cache_test.h5", H5File::CreationFlag::TRUNCATE);
+
+        H5DatasetCreateProperty dcpl;
+        dcpl.set_chunk({8, 8, 8});
+        auto ds = H5Dataset::create(hf,
+                                    "field",
+                                    H5DatatypeCreator<double>::create(),
+                                    H5Dataspace::create({16, 32, 32}),
+                                    H5LinkCreateProperty(),
+                                    dcpl);
+        std::vector<double> data(16 * 32 * 32);
+        for (size_t i = 0; i < data.size(); ++i) { data[i] = double(i); }
+        ds.write(data.data());
+        ds.close();
+
+        // a plane along axis 2 touches 2 x 4 chunks of 8^3 doubles
+        auto sweep = H5Dataset::open(hf, "field", H5AccessPattern::planes(2));
+        auto dapl  = sweep.get_access_property();
+        CHECK(dapl.get_chunk_cache_bytes() == 8 * 8 * 8 * 8 * sizeof(double));
+        CHECK(dapl.get_chunk_cache_slots() >= 100 * 8);
+        CHECK(dapl.get_chunk_cache_preemption() == 1.0);
+
+        std::vector<double> plane(16 * 32);
+        auto slab = H5Hyperslab::select(sweep.cached_dataspace(), {0, 0, 5}, {16, 32, 1});
+        sweep.read(plane.data(), H5Dataspace::create({16, 32}), slab);
+        CHECK(plane[0] == 5.0);
+        CHECK(plane[33] == double(1 * 32 * 32 + 1 * 32 + 5));
+
+        // contiguous datasets keep the given access property list
+        auto flat = H5Dataset::create(hf,
+                                      "flat",
+                                      H5DatatypeCreator<double>::create(),
+                                      H5Dataspace::create({4}));
+        flat.close();
+        CHECK(H5Dataset::open(hf, "flat", H5AccessPattern::planes(0)).is_valid());
+    }
+
+}
+
+TEST_CASE("Paged file space"){
+
+    using namespace H5Wrapper;
+
+    SECTION("properties"){
+        H5FileCreateProperty fcpl;
+        CHECK(fcpl.get_file_space_strategy() == H5F_FSPACE_STRATEGY_FSM_AGGR);
+        fcpl.set_paged_aggregation(1 << 16, true);
+        CHECK(fcpl.get_file_space_strategy() == H5F_FSPACE_STRATEGY_PAGE);
+        CHECK(fcpl.get_file_space_persist());
+        CHECK(fcpl.get_file_space_page_size() == size_t(1 << 16));
+
+        H5FileAccessProperty fapl;
+        CHECK(fapl.get_page_buffer_size() == 0);
+        fapl.set_page_buffer_size(1 << 20, 50);
+        CHECK(fapl.get_page_buffer_size() == size_t(1 << 20));
+        CHECK_THROWS_AS(fapl.set_page_buffer_size(1 << 20, 60, 50), std::runtime_error);
+    }
+
+    SECTION("page buffer needs a paged file of smaller pages"){
+        H5FileAccessProperty fapl;
+        fapl.set_serial();
+        fapl.set_page_buffer_size(8192);
+
+        const std::string fname = "paged_check_" + std::to_string(mpi_process_rank()) + ".h5";
+        CHECK_THROWS_AS(H5File::create(fname, H5File::CreationFlag::TRUNCATE,
+                                       H5FileCreateProperty(), fapl),
+                        std::runtime_error);
+
+        H5FileCreateProperty fcpl;
+        fcpl.set_paged_aggregation(1 << 16);
+        CHECK_THROWS_AS(H5File::create(fname, H5File::CreationFlag::TRUNCATE, fcpl, fapl),
+                        std::runtime_error);
+    }
+
+    SECTION("paged file with page buffer"){
+        H5FileCreateProperty fcpl;
+        fcpl.set_paged_aggregation(8192);
+        H5FileAccessProperty fapl;
+        fapl.set_serial();
+        fapl.set_page_buffer_size(16 * 8192);
+
+        const std::string fname = "paged_test_" + std::to_string(mpi_process_rank()) + ".h5";
+        {
+            auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE, fcpl, fapl);
+            for (int i = 0; i < 20; ++i) {
+                auto ds = H5Dataset::create(hf,
+                                            "small_" + std::to_string(i),
+                                            H5DatatypeCreator<int>::create(),
+                                            H5Dataspace::create({4}));
+                std::vector<int> values(4, i);
+                ds.write(values.data());
+            }
+        }
+
+        auto hf = H5File::open(fname, H5File::AccessFlag::READ, fapl);
+        CHECK(hf.get_filesize() % 8192 == 0);
+        CHECK(hf.link_names().size() == 20);
+        std::vector<int> values(4);
+        H5Dataset::open(hf, "small_13").read(values.data());
+        CHECK(values == std::vector<int>(4, 13));
+    }
+
+}
+
+TEST_CASE("Metadata cache"){
+
+    using namespace H5Wrapper;
+
+    SECTION("properties"){
+        H5FileAccessProperty fapl;
+        CHECK(fapl.get_metadata_cache_adaptive());
+        CHECK_FALSE(fapl.get_evict_on_close());
+
+        fapl.set_metadata_cache(1 << 20, 1 << 20, 1 << 20, false);
+        CHECK(fapl.get_metadata_cache_initial_size() == size_t(1 << 20));
+        CHECK(fapl.get_metadata_cache_min_size() == size_t(1 << 20));
+        CHECK(fapl.get_metadata_cache_max_size() == size_t(1 << 20));
+        CHECK_FALSE(fapl.get_metadata_cache_adaptive());
+        fapl.set_evict_on_close();
+        CHECK(fapl.get_evict_on_close());
+
+        CHECK_THROWS(fapl.set_metadata_cache(4 << 20, 1 << 20, 2 << 20));
+    }
+
+    SECTION("bounded cache with eviction on close"){
+        H5FileAccessProperty fapl;
+        fapl.set_serial();
+        fapl.set_metadata_cache(64 << 10, 64 << 10, 64 << 10, false);
+        fapl.set_evict_on_close();
+
+        const std::string fname = "mdc_test_" + std::to_string(mpi_process_rank()) + ".h5";
+        {
+            auto hf = H5File::create(
+                fname, H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+            for (int i = 0; i < 200; ++i) {
+                auto group = H5Group::create(hf, "species_" + std::to_string(i));
+                H5Group::create(group, "step_0");
+            }
+        }
+
+        auto hf = H5File::open(fname, H5File::AccessFlag::READ, fapl);
+        CHECK(hf.evict_on_close());
+        hf.reset_mdc_stats();
+        size_t n_groups = 0;
+        for (const auto& name : hf.link_names()) {
+            n_groups += H5Group::open(hf, name).link_names().size();
+        }
+        CHECK(n_groups == 200);
+
+        auto stats = hf.get_mdc_stats();
+        CHECK(stats.max_size == size_t(64 << 10));
+        CHECK(stats.current_size <= stats.max_size);
+        CHECK(stats.hit_rate > 0.0);
+        CHECK(stats.hit_rate <= 1.0);
+    }
+
+}
+
+TEST_CASE("File alignment"){
+
+    using namespace H5Wrapper;
+
+    SECTION("properties"){
+        H5FileAccessProperty fapl;
+        CHECK(fapl.get_alignment() == 1);
+        fapl.set_alignment(1 << 16, 1 << 20);
+        CHECK(fapl.get_alignment_threshold() == size_t(1 << 16));
+        CHECK(fapl.get_alignment() == size_t(1 << 20));
+        fapl.set_meta_block_size(1 << 16);
+        CHECK(fapl.get_meta_block_size() == size_t(1 << 16));
+        fapl.set_small_data_block_size(1 << 14);
+        CHECK(fapl.get_small_data_block_size() == size_t(1 << 14));
+        fapl.set_sieve_buf_size(1 << 18);
+        CHECK(fapl.get_sieve_buf_size() == size_t(1 << 18));
+
+        CHECK(H5File::file_system_block_size("alignment_test.h5") > 0);
+        CHECK(H5File::file_system_block_size("/alignment_test.h5") > 0);
+        CHECK_THROWS(H5File::file_system_block_size("no_such_dir/alignment_test.h5"));
+    }
+
+    SECTION("aligned file"){
+        const size_t block = H5File::file_system_block_size("alignment_test.h5");
+        auto hf = H5File::create_aligned("alignment_test.h5", H5File::CreationFlag::TRUNCATE);
+        CHECK(hf.get_access_property().get_alignment() == block);
+
+        const size_t n     = 2 * block / sizeof(double) + 3;
+        auto         small = H5Dataset::create(
+            hf, "small", H5DatatypeCreator<int>::create(), H5Dataspace::create({4}));
+        auto large = H5Dataset::create(
+            hf, "large", H5DatatypeCreator<double>::create(), H5Dataspace::create({n}));
+        std::vector<int>    a(4, 1);
+        std::vector<double> b(n, 2.0);
+        small.write(a.data());
+        large.write(b.data());
+        CHECK(large.get_file_offset() % block == 0);
+    }
+
+}
+
+TEST_CASE("In-memory files"){
+
+    using namespace H5Wrapper;
+
+    const std::string name = "memory_test_" + std::to_string(mpi_process_rank()) + ".h5";
+    std::remove(name.c_str());
+
+    std::vector<int> data{1, 2, 3, 4, 5, 6};
+
+    SECTION("core driver property"){
+        H5FileAccessProperty fapl;
+        fapl.set_core(1 << 16, false);
+        CHECK(fapl.get_driver() == H5FD_CORE);
+        CHECK(fapl.get_core_increment() == size_t(1 << 16));
+        CHECK_FALSE(fapl.get_core_backing_store());
+        CHECK(fapl.is_serial());
+    }
+
+    SECTION("image round trip without touching the disk"){
+        std::vector<unsigned char> image;
+        {
+            auto hf = H5File::create_in_memory(name);
+            auto ds = H5Dataset::create(
+                hf, "data", H5DatatypeCreator<int>::create(), H5Dataspace::create({2, 3}));
+            ds.write(data.data());
+            hf.set_attribute("step", 7);
+            image = hf.to_image();
+        }
+        CHECK_FALSE(H5File::exists(name));
+        CHECK(image.size() > 0);
+
+        auto hf = H5File::from_image(image);
+        CHECK(hf.read_only());
+        CHECK(hf.get_attribute<int>("step") == 7);
+        std::vector<int> read(6);
+        H5Dataset::open(hf, "data").read(read.data());
+        CHECK(read == data);
+
+        // writable copies of the same image are independent of the image and of each other
+        auto copy1 = H5File::from_image(image, H5File::AccessFlag::READANDWRITE);
+        auto copy2 = H5File::from_image(image, H5File::AccessFlag::READANDWRITE);
+        copy1.set_attribute("step", 8);
+        CHECK(copy1.get_attribute<int>("step") == 8);
+        CHECK(copy2.get_attribute<int>("step") == 7);
+        CHECK(H5File::from_image(image).get_attribute<int>("step") == 7);
+    }
+
+    SECTION("backing store"){
+        {
+            auto hf = H5File::create_in_memory(name, 1 << 16, true);
+            hf.set_attribute("step", 9);
+        }
+        REQUIRE(H5File::exists(name));
+        H5FileAccessProperty fapl;
+        fapl.set_serial();
+        auto hf = H5File::open(name, H5File::AccessFlag::READ, fapl);
+        CHECK(hf.get_attribute<int>("step") == 9);
+
+        // images of files on disk
+        auto image = hf.to_image();
+        CHECK(image.size() == hf.get_filesize());
+        CHECK(H5File::from_image(image).get_attribute<int>("step") == 9);
+    }
+
+}
+
+TEST_CASE("H5AsyncWriter"){
+
+    using namespace H5Wrapper;
+
+    // the I/O thread uses serial files, MPI-IO would require MPI_THREAD_MULTIPLE
+    H5FileAccessProperty fapl;
+    fapl.set_serial();
+    std::string fname = "async_test_" + std::to_string(mpi_process_rank()) + ".h5";
+    auto hf = H5File::create(fname, H5File::CreationFlag::TRUNCATE, H5FileCreateProperty(), fapl);
+
+    const size_t n  = 1000;
+    auto         ds = H5Dataset::create(
+        hf, "values", H5DatatypeCreator<double>::create(), H5Dataspace::create({n}));
+
+    SECTION("owned and copied buffers"){
+        H5AsyncWriter writer;
+
+        std::vector<double> data(n, 1.0);
+        auto written = writer.write(ds, std::move(data));
+        written.get();
+
+        std::vector<double> read(n);
+        ds.read(read.data());
+        CHECK(read == std::vector<double>(n, 1.0));
+
+        std::vector<double> source(n, 2.0);
+        auto copied = writer.write_copy(ds, source);
+        std::fill(source.begin(), source.end(), 3.0); // does not affect the submitted copy
+        copied.get();
+        writer.flush();
+        CHECK(writer.bytes_in_flight() == 0);
+
+        ds.read(read.data());
+        CHECK(read == std::vector<double>(n, 2.0));
+    }
+
+    SECTION("double buffering with selections"){
+        H5AsyncWriter                  writer(2 * 100 * sizeof(double));
+        std::vector<std::future<void>> futures;
+        for (size_t block = 0; block < n / 100; ++block) {
+            auto buffer = writer.make_buffer<double>({100});
+            for (size_t i = 0; i < 100; ++i) { buffer[i] = double(block * 100 + i); }
+            CHECK(writer.bytes_in_flight() <= writer.max_bytes());
+            // the selection is made while earlier writes are running
+            H5Dataspace slab = H5Hyperslab::select(ds.cached_dataspace(), {block * 100}, {100});
+            futures.push_back(writer.write(ds, std::move(buffer), slab));
+            CHECK(slab.is_valid());
+        }
+        for (auto& f : futures) { f.get(); }
+
+        std::vector<double> read(n), expected(n);
+        ds.read(read.data());
+        for (size_t i = 0; i < n; ++i) { expected[i] = double(i); }
+        CHECK(read == expected);
+    }
+
+    SECTION("errors"){
+        H5AsyncWriter writer;
+        CHECK_THROWS(writer.write_copy(ds, std::vector<double>(n + 1)));
+        CHECK(writer.bytes_in_flight() == 0);
+
+        // the write itself fails on the I/O thread and rethrows from the future
+        ds.close();
+        hf.close();
+        auto ro        = H5File::open(fname, H5File::AccessFlag::READ, fapl);
+        auto read_only = H5Dataset::open(ro, "values");
+        auto failed = writer.write_copy(read_only, std::vector<double>(n));
+        CHECK_THROWS(failed.get());
+    }
+
+}
+
 TEST_CASE("H5Property constructors"){
 
     using namespace H5Wrapper;
@@ -706,5 +2089,33 @@ TEST_CASE("H5Property constructors"){
 
     CHECK(t.is_valid());
 
+    SECTION("handle validation"){
+        CHECK_NOTHROW(H5DatasetTransferProperty(H5Pcreate(H5P_DATASET_XFER)));
+        CHECK_THROWS(H5DatasetAccessProperty(H5Pcreate(H5P_DATASET_XFER)));
+    }
+
+    SECTION("shared defaults"){
+        const auto& dxpl = default_property<H5DatasetTransferProperty>();
+        CHECK(dxpl.is_borrowed());
+        CHECK(dxpl.get_mpi_io_mode() == H5FD_MPIO_INDEPENDENT);
+        CHECK(~dxpl == H5P_DATASET_XFER_DEFAULT);
+        CHECK(&dxpl == &default_property<H5DatasetTransferProperty>());
+        CHECK(~default_property<H5FileAccessProperty>() == H5P_FILE_ACCESS_DEFAULT);
+        CHECK(~default_property<H5ObjectCreateProperty>() == H5P_DEFAULT);
+
+        const auto& coll = H5DatasetTransferProperty::collective_default();
+        CHECK(coll.is_valid());
+        CHECK(coll.get_mpi_io_mode() == H5FD_MPIO_COLLECTIVE);
+        CHECK(~coll == ~H5DatasetTransferProperty::collective_default());
+        {
+            H5DatasetTransferProperty copy = coll;
+            CHECK_THROWS(copy.set_mpi_io_mode(H5FD_MPIO_INDEPENDENT));
+        }
+        H5DatasetTransferProperty alias = dxpl;
+        CHECK_THROWS(alias.allow_type_conversion());
+        CHECK(!dxpl.type_conversion_allowed());
+        CHECK(coll.is_valid());
+    }
+
 }
 